@@ -0,0 +1,546 @@
+//benchmarks every steering behavior template of Steeriously.hpp and the
+//Update of every component, reporting nanoseconds per agent and tick.
+//
+//usage: steeriously_bench [--format csv|json] [--output file] [--filter text]
+//                         [--agents 100,1000,...] [--obstacles 10,100,...]
+//                         [--time seconds] [--seed n]
+//
+//behaviors that look at obstacles or walls are run for every obstacle count,
+//the same number of walls is used. Every case runs until the time budget is
+//used up - checked every few agents, so even the largest cases finish - and
+//reports the time per agent evaluated.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <steeriously/libinc.hpp>
+#include <steeriously/Steeriously.hpp>
+
+using namespace steer;
+
+namespace
+{
+    //agents are spread so each one has about this much room whatever their
+    //number, which keeps the number of neighbors the same across counts
+    const float SpacePerAgent = 100.f;
+
+    //time is looked at after this many agents
+    const Uint32 Batch = 64;
+
+    const float Dt = 1.f / 60.f;
+
+    struct Options
+    {
+        std::string             format = "csv";
+        std::string             output;
+        std::string             filter;
+        std::vector<Uint32>     agents = { 100, 1000, 10000, 100000 };
+        std::vector<Uint32>     obstacles = { 10, 100, 1000, 10000 };
+        double                  time = 0.1;
+        Uint64                  seed = 1;
+    };
+
+    struct Result
+    {
+        std::string name;
+        Uint32      agents;
+        Uint32      obstacles;
+        Uint32      walls;
+        Uint64      samples;
+        double      nsPerAgentTick;
+    };
+
+    //everything the behaviors steer around, for one obstacle count
+    struct Scene
+    {
+        std::vector<SphereObstacle*>    obstacles;
+        std::vector<Wall*>              walls;
+        ObstacleIndex                   obstacleIndex;
+        WallIndex                       wallIndex;
+
+        ~Scene()
+        {
+            DeleteSTLContainer(obstacles);
+            DeleteSTLContainer(walls);
+        }
+    };
+
+    std::vector<Uint32> parseList(const char* text)
+    {
+        std::vector<Uint32> values;
+
+        while (*text != '\0')
+        {
+            char* end = nullptr;
+            Uint32 value = (Uint32)strtoul(text, &end, 10);
+
+            //not a number
+            if (end == text)
+                break;
+
+            values.push_back(value);
+
+            text = *end == ',' ? end + 1 : end;
+        }
+
+        return values;
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+            if (arg == "--help" || arg == "-h" || value == nullptr)
+                return false;
+
+            if (arg == "--format")
+                options.format = value;
+            else if (arg == "--output")
+                options.output = value;
+            else if (arg == "--filter")
+                options.filter = value;
+            else if (arg == "--agents")
+                options.agents = parseList(value);
+            else if (arg == "--obstacles")
+                options.obstacles = parseList(value);
+            else if (arg == "--time")
+                options.time = atof(value);
+            else if (arg == "--seed")
+                options.seed = strtoull(value, nullptr, 10);
+            else
+                return false;
+
+            ++i;
+        }
+
+        return options.format == "csv" || options.format == "json";
+    }
+
+    float areaSize(Uint32 agents)
+    {
+        return sqrtf((float)agents) * SpacePerAgent;
+    }
+
+    Vector2 randomPosition(float size)
+    {
+        return Vector2(RandInRange(0.f, size), RandInRange(0.f, size));
+    }
+
+    void buildScene(Scene& scene, float size, Uint32 count, const BehaviorParameters& params)
+    {
+        for (Uint32 i = 0; i < count; ++i)
+        {
+            scene.obstacles.push_back(new SphereObstacle(randomPosition(size), RandInRange(params.MinObstacleRadius, params.MaxObstacleRadius)));
+
+            Vector2 from = randomPosition(size);
+            Vector2 to = from + Vector2(RandInRange(-100.f, 100.f), RandInRange(-100.f, 100.f));
+
+            scene.walls.push_back(new Wall(false, from, to));
+        }
+
+        scene.obstacleIndex.build(scene.obstacles);
+        scene.wallIndex.build(scene.walls);
+    }
+
+    //a looped patrol route across the area, shared by every agent
+    std::shared_ptr<PathData> makePath(float size)
+    {
+        std::vector<Vector2> waypoints;
+
+        for (Uint32 i = 0; i < 16; ++i)
+            waypoints.push_back(randomPosition(size));
+
+        return std::make_shared<PathData>(std::move(waypoints), true);
+    }
+
+    //places agents of any component type at random across the area, moving
+    //in random directions
+    template <class C>
+    void placeAgents(std::vector<C*>& agents, Uint32 count, float size, BehaviorParameters& params)
+    {
+        agents.reserve(count);
+
+        for (Uint32 i = 0; i < count; ++i)
+        {
+            params.position = randomPosition(size);
+
+            C* agent = new C(&params);
+            agent->m_velocity = Vector2(RandInRange(-1.f, 1.f), RandInRange(-1.f, 1.f)) * (params.MaxSpeed * 0.5f);
+            agent->setTarget(randomPosition(size));
+
+            agents.push_back(agent);
+        }
+    }
+
+    //calls run for agents 0, 1, 2... wrapping around, until the budget is
+    //used up, and returns the time per call
+    double measure(Uint32 count, double budget, Uint64& samples, const std::function<void(Uint32)>& run)
+    {
+        typedef std::chrono::steady_clock Clock;
+
+        //one untimed batch to warm the caches up
+        for (Uint32 i = 0; i < MinOf(count, Batch); ++i)
+            run(i);
+
+        samples = 0;
+
+        Uint32 next = 0;
+        Clock::time_point start = Clock::now();
+        double elapsed = 0.0;
+
+        do
+        {
+            for (Uint32 i = 0; i < Batch; ++i)
+            {
+                run(next);
+
+                if (++next == count)
+                    next = 0;
+            }
+
+            samples += Batch;
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        while (elapsed < budget);
+
+        return elapsed * 1e9 / (double)samples;
+    }
+
+    class Runner
+    {
+    public:
+
+        explicit Runner(const Options& options) : m_options(options) {}
+
+        bool wanted(const std::string& name) const
+        {
+            return m_options.filter.empty() || name.find(m_options.filter) != std::string::npos;
+        }
+
+        void record(const std::string& name, Uint32 agents, Uint32 obstacles, const std::function<void(Uint32)>& run)
+        {
+            Result result;
+            result.name = name;
+            result.agents = agents;
+            result.obstacles = obstacles;
+            result.walls = obstacles;
+            result.nsPerAgentTick = measure(agents, m_options.time, result.samples, run);
+
+            fprintf(stderr, "%-32s agents %7u obstacles %6u  %12.1f ns/agent/tick\n", name.c_str(), agents, obstacles, result.nsPerAgentTick);
+
+            m_results.push_back(result);
+        }
+
+        const std::vector<Result>& results() const { return m_results; }
+
+    private:
+
+        const Options&      m_options;
+        std::vector<Result> m_results;
+    };
+
+    //the behavior templates, called on SuperComponent agents
+    void benchTemplates(Runner& runner, Uint32 count, const Scene* scene, Uint32 obstacles, BehaviorParameters params)
+    {
+        std::vector<SuperComponent*> agents;
+        placeAgents(agents, count, areaSize(count), params);
+
+        SpatialHashGrid grid(params);
+
+        for (auto& agent : agents)
+            agent->setCellSpace(&grid);
+
+        std::vector<Agent*> neighbors;
+        NeighborPack pack;
+
+        auto other = [&agents](Uint32 i) { return agents[(i * 7919u + 1u) % agents.size()]; };
+
+        if (scene == nullptr)
+        {
+            std::vector<PathCursor> cursors(count);
+            std::shared_ptr<PathData> path = makePath(areaSize(count));
+
+            for (auto& cursor : cursors)
+                cursor.set(path.get());
+
+            if (runner.wanted("Seek"))
+                runner.record("Seek", count, 0, [&](Uint32 i) { agents[i]->m_steeringForce = Seek(agents[i]); });
+
+            if (runner.wanted("Flee"))
+                runner.record("Flee", count, 0, [&](Uint32 i) { agents[i]->m_steeringForce = Flee(agents[i]); });
+
+            if (runner.wanted("Arrive"))
+                runner.record("Arrive", count, 0, [&](Uint32 i) { agents[i]->m_steeringForce = Arrive(agents[i], agents[i]->m_deceleration); });
+
+            if (runner.wanted("Pursuit"))
+                runner.record("Pursuit", count, 0, [&](Uint32 i) { agents[i]->m_steeringForce = Pursuit(agents[i], other(i)); });
+
+            if (runner.wanted("Evade"))
+                runner.record("Evade", count, 0, [&](Uint32 i) { agents[i]->m_steeringForce = Evade(agents[i], other(i)); });
+
+            if (runner.wanted("OffsetPursuit"))
+                runner.record("OffsetPursuit", count, 0, [&](Uint32 i) { agents[i]->m_steeringForce = OffsetPursuit(agents[i], other(i), params); });
+
+            if (runner.wanted("Interpose"))
+                runner.record("Interpose", count, 0, [&](Uint32 i) { agents[i]->m_steeringForce = Interpose(agents[i], other(i), other(i + 1), params); });
+
+            if (runner.wanted("Wander"))
+                runner.record("Wander", count, 0, [&](Uint32 i) { agents[i]->m_steeringForce = Wander(agents[i]); });
+
+            if (runner.wanted("PathFollowing"))
+                runner.record("PathFollowing", count, 0, [&](Uint32 i) { agents[i]->m_steeringForce = PathFollowing(agents[i], cursors[i], params); });
+
+            if (runner.wanted("Separation"))
+                runner.record("Separation", count, 0, [&](Uint32 i)
+                {
+                    GatherVehiclesWithinViewRange(agents[i], grid, agents[i]->m_viewDistance, neighbors);
+                    agents[i]->m_steeringForce = Separation(agents[i], neighbors, AnyNeighbor());
+                });
+
+            if (runner.wanted("Alignment"))
+                runner.record("Alignment", count, 0, [&](Uint32 i)
+                {
+                    GatherVehiclesWithinViewRange(agents[i], grid, agents[i]->m_viewDistance, neighbors);
+                    agents[i]->m_steeringForce = Alignment(agents[i], neighbors, AnyNeighbor());
+                });
+
+            if (runner.wanted("Cohesion"))
+                runner.record("Cohesion", count, 0, [&](Uint32 i)
+                {
+                    GatherVehiclesWithinViewRange(agents[i], grid, agents[i]->m_viewDistance, neighbors);
+                    agents[i]->m_steeringForce = Cohesion(agents[i], neighbors, AnyNeighbor());
+                });
+
+            if (runner.wanted("Flocking"))
+                runner.record("Flocking", count, 0, [&](Uint32 i)
+                {
+                    GatherVehiclesWithinViewRange(agents[i], grid, agents[i]->m_viewDistance, neighbors);
+                    FlockingForces forces = Flocking(agents[i], neighbors, pack, AnyNeighbor());
+                    agents[i]->m_steeringForce = forces.separation + forces.alignment + forces.cohesion;
+                });
+        }
+        else
+        {
+            if (runner.wanted("ObstacleAvoidance/list"))
+                runner.record("ObstacleAvoidance/list", count, obstacles, [&](Uint32 i) { agents[i]->m_steeringForce = ObstacleAvoidance(agents[i], scene->obstacles, params); });
+
+            if (runner.wanted("ObstacleAvoidance/index"))
+                runner.record("ObstacleAvoidance/index", count, obstacles, [&](Uint32 i) { agents[i]->m_steeringForce = ObstacleAvoidance(agents[i], scene->obstacleIndex, params); });
+
+            if (runner.wanted("Hide/list"))
+                runner.record("Hide/list", count, obstacles, [&](Uint32 i) { agents[i]->m_steeringForce = Hide(agents[i], other(i), scene->obstacles, params); });
+
+            if (runner.wanted("Hide/index"))
+                runner.record("Hide/index", count, obstacles, [&](Uint32 i) { agents[i]->m_steeringForce = Hide(agents[i], other(i), scene->obstacleIndex, params); });
+
+            if (runner.wanted("WallAvoidance/list"))
+                runner.record("WallAvoidance/list", count, obstacles, [&](Uint32 i) { agents[i]->m_steeringForce = WallAvoidance(agents[i], scene->walls); });
+
+            if (runner.wanted("WallAvoidance/index"))
+                runner.record("WallAvoidance/index", count, obstacles, [&](Uint32 i) { agents[i]->m_steeringForce = WallAvoidance(agents[i], scene->wallIndex); });
+        }
+
+        DeleteSTLContainer(agents);
+    }
+
+    //the Update of one component type, setup hands each agent what it needs
+    template <class C>
+    void benchComponent(Runner& runner, const std::string& name, Uint32 count, Uint32 obstacles, BehaviorParameters params,
+                        const std::function<void(std::vector<C*>&, Uint32)>& setup)
+    {
+        if (!runner.wanted(name))
+            return;
+
+        std::vector<C*> agents;
+        placeAgents(agents, count, areaSize(count), params);
+
+        for (Uint32 i = 0; i < count; ++i)
+            setup(agents, i);
+
+        runner.record(name, count, obstacles, [&agents](Uint32 i) { agents[i]->Update(Dt); });
+
+        DeleteSTLContainer(agents);
+    }
+
+    void benchComponents(Runner& runner, Uint32 count, const Scene* scene, Uint32 obstacles, const BehaviorParameters& params)
+    {
+        auto other = [](Uint32 i, Uint32 n) { return (i * 7919u + 1u) % n; };
+
+        if (scene == nullptr)
+        {
+            std::shared_ptr<PathData> path = makePath(areaSize(count));
+
+            benchComponent<SeekComponent>(runner, "SeekComponent", count, 0, params, [](std::vector<SeekComponent*>&, Uint32) {});
+            benchComponent<FleeComponent>(runner, "FleeComponent", count, 0, params, [](std::vector<FleeComponent*>&, Uint32) {});
+            benchComponent<ArriveComponent>(runner, "ArriveComponent", count, 0, params, [](std::vector<ArriveComponent*>&, Uint32) {});
+            benchComponent<WanderComponent>(runner, "WanderComponent", count, 0, params, [](std::vector<WanderComponent*>&, Uint32) {});
+
+            benchComponent<PursuitComponent>(runner, "PursuitComponent", count, 0, params, [&](std::vector<PursuitComponent*>& a, Uint32 i)
+            {
+                a[i]->setTargetAgent(a[other(i, count)]);
+            });
+
+            benchComponent<EvadeComponent>(runner, "EvadeComponent", count, 0, params, [&](std::vector<EvadeComponent*>& a, Uint32 i)
+            {
+                a[i]->setTargetAgent(a[other(i, count)]);
+            });
+
+            benchComponent<OffsetPursuitComponent>(runner, "OffsetPursuitComponent", count, 0, params, [&](std::vector<OffsetPursuitComponent*>& a, Uint32 i)
+            {
+                a[i]->setLeader(a[other(i, count)]);
+                a[i]->setOffset(Vector2(10.f, 10.f));
+            });
+
+            benchComponent<InterposeComponent>(runner, "InterposeComponent", count, 0, params, [&](std::vector<InterposeComponent*>& a, Uint32 i)
+            {
+                a[i]->setAgents(a[other(i, count)], a[other(i + 1, count)]);
+            });
+
+            benchComponent<PathFollowingComponent>(runner, "PathFollowingComponent", count, 0, params, [&](std::vector<PathFollowingComponent*>& a, Uint32 i)
+            {
+                a[i]->setPathData(path.get());
+            });
+
+            return;
+        }
+
+        SpatialHashGrid grid(params);
+
+        benchComponent<HideComponent>(runner, "HideComponent", count, obstacles, params, [&](std::vector<HideComponent*>& a, Uint32 i)
+        {
+            a[i]->setTargetAgent(a[other(i, count)]);
+            a[i]->setObstacles(const_cast<std::vector<SphereObstacle*>*>(&scene->obstacles));
+            a[i]->setObstacleIndex(&scene->obstacleIndex);
+        });
+
+        benchComponent<FlockingComponent>(runner, "FlockingComponent", count, obstacles, params, [&](std::vector<FlockingComponent*>& a, Uint32 i)
+        {
+            a[i]->setNeighbors(&a);
+            a[i]->setCellSpace(&grid);
+            a[i]->setObstacles(const_cast<std::vector<SphereObstacle*>*>(&scene->obstacles));
+            a[i]->setObstacleIndex(&scene->obstacleIndex);
+            a[i]->setWalls(const_cast<std::vector<Wall*>*>(&scene->walls));
+            a[i]->setWallIndex(&scene->wallIndex);
+            a[i]->obstacleAvoidanceOn();
+            a[i]->wallAvoidanceOn();
+        });
+
+        benchComponent<SuperComponent>(runner, "SuperComponent", count, obstacles, params, [&](std::vector<SuperComponent*>& a, Uint32 i)
+        {
+            a[i]->setNeighbors(&a);
+            a[i]->setCellSpace(&grid);
+            a[i]->setObstacles(const_cast<std::vector<SphereObstacle*>*>(&scene->obstacles));
+            a[i]->setObstacleIndex(&scene->obstacleIndex);
+            a[i]->setWalls(const_cast<std::vector<Wall*>*>(&scene->walls));
+            a[i]->setWallIndex(&scene->wallIndex);
+            a[i]->separationOn();
+            a[i]->alignmentOn();
+            a[i]->cohesionOn();
+            a[i]->wanderOn();
+            a[i]->obstacleAvoidanceOn();
+            a[i]->wallAvoidanceOn();
+        });
+    }
+
+    void writeCsv(FILE* out, const std::vector<Result>& results)
+    {
+        fprintf(out, "benchmark,agents,obstacles,walls,samples,ns_per_agent_tick\n");
+
+        for (auto& r : results)
+            fprintf(out, "%s,%u,%u,%u,%llu,%.3f\n", r.name.c_str(), r.agents, r.obstacles, r.walls, (unsigned long long)r.samples, r.nsPerAgentTick);
+    }
+
+    void writeJson(FILE* out, const std::vector<Result>& results, const Options& options)
+    {
+        fprintf(out, "{\n  \"context\": {\n");
+        fprintf(out, "    \"scalar\": \"%s\",\n", sizeof(Vector2) == 2 * sizeof(float) ? "float" : "double");
+        fprintf(out, "    \"time_per_case\": %g,\n", options.time);
+        fprintf(out, "    \"seed\": %llu\n", (unsigned long long)options.seed);
+        fprintf(out, "  },\n  \"benchmarks\": [\n");
+
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& r = results[i];
+
+            fprintf(out, "    { \"benchmark\": \"%s\", \"agents\": %u, \"obstacles\": %u, \"walls\": %u, \"samples\": %llu, \"ns_per_agent_tick\": %.3f }%s\n",
+                    r.name.c_str(), r.agents, r.obstacles, r.walls, (unsigned long long)r.samples, r.nsPerAgentTick,
+                    i + 1 < results.size() ? "," : "");
+        }
+
+        fprintf(out, "  ]\n}\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    if (!parseOptions(argc, argv, options))
+    {
+        fprintf(stderr, "usage: %s [--format csv|json] [--output file] [--filter text]\n"
+                        "          [--agents 100,1000,...] [--obstacles 10,100,...] [--time seconds] [--seed n]\n", argv[0]);
+        return 1;
+    }
+
+    BehaviorParameters params;
+
+    //agents of the benchmarks never fall asleep
+    params.SleepDelay = 0.f;
+
+    Runner runner(options);
+
+    for (auto count : options.agents)
+    {
+        if (count == 0)
+            continue;
+
+        ThreadRandomStream().seek(options.seed, count);
+
+        benchTemplates(runner, count, nullptr, 0, params);
+        benchComponents(runner, count, nullptr, 0, params);
+
+        for (auto obstacles : options.obstacles)
+        {
+            ThreadRandomStream().seek(options.seed, ((Uint64)count << 32) | obstacles);
+
+            Scene scene;
+            buildScene(scene, areaSize(count), obstacles, params);
+
+            benchTemplates(runner, count, &scene, obstacles, params);
+            benchComponents(runner, count, &scene, obstacles, params);
+        }
+    }
+
+    FILE* out = stdout;
+
+    if (!options.output.empty())
+    {
+        out = fopen(options.output.c_str(), "w");
+
+        if (out == nullptr)
+        {
+            fprintf(stderr, "could not open %s\n", options.output.c_str());
+            return 1;
+        }
+    }
+
+    if (options.format == "json")
+        writeJson(out, runner.results(), options);
+    else
+        writeCsv(out, runner.results());
+
+    if (out != stdout)
+        fclose(out);
+
+    return 0;
+}
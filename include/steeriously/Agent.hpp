@@ -2,15 +2,28 @@
 #ifndef AGENT_HPP
 #define AGENT_HPP
 
+#include <array>
 #include <vector>
 
+#include <steeriously/AgentRegistry.hpp>
 #include <steeriously/BehaviorData.hpp>
+#include <steeriously/SpatialHashGrid.hpp>
 #include <steeriously/Utilities.hpp>
 #include <steeriously/Vector2.hpp>
 #include <steeriously/VectorMath.hpp>
 
 namespace steer //steeriously namespace
 {
+    /**
+    *\struct AgentState
+    *\brief The state of an agent other agents steer against, published once per frame by double-buffered agents.
+    **/
+    struct AgentState
+    {
+        steer::Vector2  position;///< Published position.
+        steer::Vector2  velocity;///< Published velocity.
+        steer::Vector2  heading;///< Published heading.
+    };
 
     /**
     *\class Agent
@@ -65,7 +78,25 @@ namespace steer //steeriously namespace
 		\brief Sets the position of the entity.
 		\param newPosition - a steer::Vector2 of floats.
 		**/
-		void setPosition(steer::Vector2 newPosition) { m_agentPosition = newPosition; };
+		void setPosition(steer::Vector2 newPosition)
+		{
+			steer::Vector2 oldPosition = m_agentPosition;
+			m_agentPosition = newPosition;
+			updateCell(oldPosition);
+		};
+
+		/**
+		\fn float getRotation() const;
+		\brief Gets the rotation of the agent in degrees, derived from its velocity - useful for applying to drawables and other entities.
+		**/
+		float getRotation() const { return m_rotation; }
+
+		/**
+		\fn void setRotation(float r);
+		\brief Sets the rotation of the agent in degrees.
+		\param r - a plain old float.
+		**/
+		void setRotation(float r) { m_rotation = r; }
 
 		/**
 		\fn float getBoundingRadius() const;
@@ -76,9 +107,15 @@ namespace steer //steeriously namespace
 		/**
 		\fn void setBoundingRadius(float radius);
 		\param radius - a plain old float.
-		\brief Sets the bounding radius of the entity.
+		\brief Sets the bounding radius of the entity, and lets its cell space partition know so queries still reach it.
 		**/
-		void setBoundingRadius(float radius) { m_boundingRadius = radius; };
+		void setBoundingRadius(float radius)
+		{
+			m_boundingRadius = radius;
+
+			if (m_cellSpace != nullptr)
+				m_cellSpace->updateRadius(radius);
+		};
 
 		/**
 		\fn bool taggedInGroup() const;
@@ -251,7 +288,14 @@ namespace steer //steeriously namespace
 		\brief Sets the current target for the owner agent.
 		\param target - a steer::Vector2 of floats.
 		**/
-		void setTarget(const steer::Vector2 target) { m_target = target; };
+		void setTarget(const steer::Vector2 target)
+		{
+			//a sleeping agent wakes up when it is sent somewhere new
+			if (target != m_target)
+				wake();
+
+			m_target = target;
+		};
 
 		/**
 		\fn void getTarget() const;
@@ -382,10 +426,90 @@ namespace steer //steeriously namespace
 		void setBoxLength(const float length) { m_boxLength = length; }
 
 		/**
-		\fn const std::vector<steer::Vector2>& getFeelers()const;
+		\fn const std::array<steer::Vector2, 3>& getFeelers()const;
 		\brief Returns a reference to the feelers used for obstacle and wall avoidance;
 		**/
-		const std::vector<steer::Vector2>& getFeelers() const { return m_feelers; }
+		const std::array<steer::Vector2, 3>& getFeelers() const { return m_feelers; }
+
+		/**
+		\fn void setCellSpace(steer::SpatialHashGrid* grid);
+		\brief Registers the agent with a cell space partition (or removes it from its current one when passed nullptr). Neighborhood queries then only visit the cells around the agent.
+		\param grid - a pointer to a steer::SpatialHashGrid.
+		**/
+		void setCellSpace(steer::SpatialHashGrid* grid);
+
+		/**
+		\fn steer::SpatialHashGrid* getCellSpace() const;
+		\brief Returns the cell space partition the agent is registered with, or nullptr.
+		**/
+		steer::SpatialHashGrid* getCellSpace() const { return m_cellSpace; }
+
+		/**
+		\fn void updateCell(steer::Vector2 oldPosition);
+		\brief Moves the agent between the buckets of its cell space partition when it has crossed into another cell. Does nothing without a partition.
+		<br />Call this after writing m_agentPosition directly - setPosition and the Update methods of the components take care of it.
+		A double-buffered agent is binned at its published position, publishState moves it instead.
+		\param oldPosition - a steer::Vector2, the position before the move.
+		**/
+		void updateCell(steer::Vector2 oldPosition)
+		{
+			if (m_cellSpace != nullptr && !m_doubleBuffered)
+				m_cellSpace->updateEntity(this, oldPosition);
+		}
+
+		/**
+		\fn void setDoubleBuffered(bool doubleBuffered);
+		\brief Switches the agent between double-buffered and single-buffered state (the default).
+		<br />Other agents - flocking neighbors, pursuers, evaders and so on - read the published state of a double-buffered agent,
+		so they keep seeing last frame's snapshot while the agent writes next frame's state, no matter which agent updates first.
+		Call publishState (or steer::PublishStates) once every agent has been updated to make the new state visible.
+		\param doubleBuffered - a bool.
+		**/
+		void setDoubleBuffered(bool doubleBuffered);
+
+		/**
+		\fn bool isDoubleBuffered() const;
+		\brief Returns true if other agents read the published state of the agent.
+		**/
+		bool isDoubleBuffered() const { return m_doubleBuffered; }
+
+		/**
+		\fn void publishState();
+		\brief Makes the current position, velocity and heading of a double-buffered agent visible to other agents and moves it between cells of its partition.
+		**/
+		void publishState();
+
+		/**
+		\fn steer::Vector2 getPublishedPosition() const;
+		\brief Gets the position other agents steer against - the published one for a double-buffered agent, otherwise the current one.
+		**/
+		steer::Vector2 getPublishedPosition() const { return m_doubleBuffered ? m_published.position : m_agentPosition; }
+
+		/**
+		\fn steer::Vector2 getPublishedVelocity() const;
+		\brief Gets the velocity other agents steer against - the published one for a double-buffered agent, otherwise the current one.
+		**/
+		steer::Vector2 getPublishedVelocity() const { return m_doubleBuffered ? m_published.velocity : m_velocity; }
+
+		/**
+		\fn steer::Vector2 getPublishedHeading() const;
+		\brief Gets the heading other agents steer against - the published one for a double-buffered agent, otherwise the current one.
+		**/
+		steer::Vector2 getPublishedHeading() const { return m_doubleBuffered ? m_published.heading : m_heading; }
+
+		/**
+		\fn float getPublishedSpeed() const;
+		\brief Gets the length of the published velocity.
+		**/
+		float getPublishedSpeed() const { return VectorMath::length(getPublishedVelocity()); }
+
+		/**
+		\fn void integrate(float dt);
+		\brief Moves the agent according to its current steering force: acceleration = force/mass, velocity is capped at the max speed, heading and side follow the velocity.
+		<br />The Update methods of the components call Calculate and integrate back to back. steer::AgentStore provides the same integration for many agents at once.
+		\param dt - a plain old float.
+		**/
+		void integrate(float dt);
 
 		/**
 		\fn virtual bool on(behaviorType behavior) = 0;
@@ -397,13 +521,19 @@ namespace steer //steeriously namespace
 		/**
 		\fn virtual void setSummingMethod(summingMethod sumMethod);
 		\brief A virtual method used for setting the summing method for steering forces.
-		\param sumMethod - an Uint32.
+		\param sumMethod - an Uint32, SEE SUMMINGMETHOD ENUM in BEHAVIORDATA.HPP.
 		**/
 		virtual void setSummingMethod(Uint32 sumMethod);
 
+		/**
+		\fn Uint32 getSummingMethod() const;
+		\brief Gets the summing method for steering forces.
+		**/
+		Uint32 getSummingMethod() const { return m_summingMethod; }
+
 		/**
 		\fn  virtual bool accumulateForce(steer::Vector2 &startingForce, steer::Vector2 forceToAdd);
-		\brief A virtual method used to accumulate forces from a combination of behaviors. Does nothing, override and implement in derived classes.
+		\brief A virtual method used to accumulate forces from a combination of behaviors. Adds as much of the force as the max force has left and returns false once nothing is left.
 		\param startingForce - a steer::Vector2 of floats.
 		\param forceToAdd - a steer::Vector2 of floats.
 		**/
@@ -421,6 +551,36 @@ namespace steer //steeriously namespace
 		**/
 		virtual steer::Vector2 calculatePrioritized();
 
+		/**
+		\fn virtual steer::Vector2 calculateDithered();
+		\brief A virtual method that evaluates each behavior with some probability and returns the first non zero force. Does nothing, override and implement in derived classes.
+		**/
+		virtual steer::Vector2 calculateDithered();
+
+		/**
+		\fn template <class Force> bool ditherForce(steer::behaviorType behavior, float probability, float weight, Force force);
+		\brief One step of calculateDithered. If the behavior is on, rolls it with some probability and sets the steering force to the weighted force scaled up by the inverse of the probability, truncated to the max force. Returns true if that force is not zero.
+		\param behavior - a steer::behaviorType.
+		\param probability - a plain old float, the chance the behavior is evaluated.
+		\param weight - a plain old float.
+		\param force - a callable returning the steer::Vector2 force of the behavior, only called when the roll succeeds.
+		**/
+		template <class Force>
+		bool ditherForce(steer::behaviorType behavior, float probability, float weight, Force force)
+		{
+			if (!on(behavior) || m_random.nextFloat() >= probability)
+				return false;
+
+			m_steeringForce = force() * weight / probability;
+
+			if (m_steeringForce.isZero())
+				return false;
+
+			m_steeringForce = steer::VectorMath::truncate(m_steeringForce, getMaxForce());
+
+			return true;
+		}
+
 		/**
 		\fn virtual steer::Vector2 Calculate();
 		\brief A pure virtual method for calculating the steering vector.
@@ -439,6 +599,108 @@ namespace steer //steeriously namespace
 		**/
 		float setElapsedTime(float e) { m_timeElapsed = e; };
 
+		/**
+		* \fn bool isAsleep() const;
+		* \brief Returns true if the agent is asleep - a steer::World neither computes its steering force nor moves it.
+		**/
+		bool isAsleep() const { return m_asleep; };
+
+		/**
+		* \fn void sleep();
+		* \brief Puts the agent to sleep, stopping it.
+		**/
+		void sleep();
+
+		/**
+		* \fn void wake();
+		* \brief Wakes the agent up if it is asleep.
+		**/
+		void wake();
+
+		/**
+		* \fn void applyForce(const steer::Vector2 force);
+		* \brief Adds an external force, applied along with the steering force on the next integration only. Wakes the agent up.
+		* \param force - a steer::Vector2 of floats.
+		**/
+		void applyForce(const steer::Vector2 force);
+
+		/**
+		* \fn void setSleepThresholds(float speed, float force, float delay);
+		* \brief Sets how still the agent has to be to fall asleep.
+		* \param speed - a plain old float, the speed the agent has to stay under.
+		* \param force - a plain old float, the steering force the agent has to stay under.
+		* \param delay - a plain old float, seconds the agent has to stay under both before falling asleep, zero keeps it awake.
+		**/
+		void setSleepThresholds(float speed, float force, float delay) { m_sleepSpeed = speed; m_sleepForce = force; m_sleepDelay = delay; };
+
+		/**
+		* \fn bool updateRest(float dt);
+		* \brief Counts the time the agent has been at rest and puts it to sleep once it exceeds the sleep delay. Returns true if the agent fell asleep.
+		* <br />Unlike sleep, it does not raise the wake flag - the caller is expected to notice the returned value.
+		* \param dt - a plain old float.
+		**/
+		bool updateRest(float dt);
+
+		/**
+		* \fn void setWakeFlag(bool* flag);
+		* \brief Sets a flag raised whenever the agent falls asleep or wakes up, steer::World uses it to refresh its list of awake agents.
+		* \param flag - a pointer to a bool, or null.
+		**/
+		void setWakeFlag(bool* flag) { m_wakeFlag = flag; };
+
+		/**
+		* \fn Uint32 getId() const;
+		* \brief Get the id of the agent, unique among agents unless set by hand.
+		**/
+		Uint32 getId() const { return m_id; };
+
+		/**
+		* \fn void setId(Uint32 id);
+		* \brief Set the id of the agent, which also keys its random stream - give agents the same ids to replay a simulation.
+		* \param id - an Uint32.
+		**/
+		void setId(Uint32 id) { m_id = id; m_random.seek(id, m_random.getTick()); };
+
+		/**
+		* \fn steer::RandomStream& getRandom();
+		* \brief Get the random stream of the agent, keyed by its id.
+		**/
+		steer::RandomStream& getRandom() { return m_random; };
+
+		/**
+		* \fn void setTick(Uint64 tick);
+		* \brief Re-keys the random stream of the agent with the frame number, so what the agent draws during a frame only depends on its id and the frame.
+		* \param tick - an Uint64.
+		**/
+		void setTick(Uint64 tick) { m_random.seek(m_id, tick); };
+
+		/**
+		* \fn steer::AgentHandle getHandle() const;
+		* \brief Get the handle of the agent in the registry it was added to, invalid if it was not.
+		**/
+		steer::AgentHandle getHandle() const { return m_handle; };
+
+		/**
+		* \fn void setRegistry(const steer::AgentRegistry* registry, steer::AgentHandle handle);
+		* \brief Hands the agent the registry it was added to and its handle there. References made to the agent resolve through that registry.
+		* \param registry - a pointer to a steer::AgentRegistry, or null.
+		* \param handle - a steer::AgentHandle.
+		**/
+		void setRegistry(const steer::AgentRegistry* registry, steer::AgentHandle handle) { m_registry = registry; m_handle = handle; };
+
+		/**
+		* \fn const steer::AgentRegistry* getRegistry() const;
+		* \brief Get the registry the agent was added to, null if it was not.
+		**/
+		const steer::AgentRegistry* getRegistry() const { return m_registry; };
+
+		/**
+		* \fn steer::Agent* resolve(const steer::AgentRef& ref) const;
+		* \brief Returns the agent a reference names - through the registry of the reference when it holds a handle, null once that agent was removed.
+		* \param ref - a steer::AgentRef.
+		**/
+		steer::Agent* resolve(const steer::AgentRef& ref) const { return ref.resolve(); };
+
         //all data are public
         //getters/setters provided for anyone that wants them...
         //Since the whole purpose of this library is to
@@ -446,11 +708,16 @@ namespace steer //steeriously namespace
 	public:
 		steer::Vector2								m_agentPosition;///< The Entity's internal position value.
 		steer::Vector2								m_scale;///< The Entity's internal scale value.
+		float										m_rotation;///< Rotation of the agent for applying to drawables and other entities.
 		bool										m_tag;/// Generic flag to indicate that the entity is flagged for some process.
 		float										m_boundingRadius;///< The Entity's internal bounding radius value.
 		steer::Vector2                              m_steeringForce;///< For calculating the steering force internally from all combined behaviors.
 		float                                       m_waypointSeekDistanceSquared;///< the distance (squared) a vehicle has to be from a path waypoint before it starts seeking to the next waypoint
-		std::vector<steer::Vector2>                 m_feelers;///< a vertex buffer to contain the feelers for wall avoidance
+		std::array<steer::Vector2, 3>               m_feelers;///< the feelers for wall avoidance, held inline
+		steer::SpatialHashGrid*                     m_cellSpace;///< optional cell space partition the agent is registered with
+		std::vector<steer::Agent*>                  m_neighborhood;///< neighbors gathered from the cell space partition on the last query
+		steer::AgentState                           m_published;///< state other agents read while the agent is double-buffered
+		bool                                        m_doubleBuffered;///< flag to indicate other agents read the published state
 		steer::Vector2                              m_velocity;///< Storage for the agent's velocity.
 		steer::Vector2                              m_heading;///< Storage for the agent's normalized vector pointing in the direction it is headed.
 		steer::Vector2                              m_side;///< A vector perpendicular to the direction the agent is heading.
@@ -464,6 +731,7 @@ namespace steer //steeriously namespace
 		float                                       m_maxSpeed;///< The maximum speed at which the agent can travel.
 		float                                       m_maxForce;///< The maximum force the agent can use to propel itself.
 		float                                       m_maxTurnRate;///< The maximum rate at which the agent can rotate.
+		Uint32                                      m_summingMethod;///< Summing method for steering forces - SEE SUMMINGMETHOD ENUM IN BEHAVIORDATA.HPP
 		steer::Vector2                              m_target;///< For setting the agent's target.
 		float										m_threatRange;///<  Range the object of interest must be in to trigger evasive action.
 		float										m_decelerationTweaker;///< Value used to tweak deceleration.
@@ -472,6 +740,17 @@ namespace steer //steeriously namespace
 		float										m_wanderJitter;///< Amount of displacement along the constraining circle for the wandering agent.
 		float										m_wanderRadius;///< The radius of the constraining circle for the wandering agent.
 		float										m_wanderDistance;///< Distance the wander circle is projected in front of the agent.
+		steer::Vector2                              m_externalForce;///< External forces applied since the last integration.
+		bool                                        m_asleep;///< Flag to indicate the agent is asleep.
+		float                                       m_restTime;///< Seconds the agent has been at rest for.
+		float                                       m_sleepSpeed;///< Speed the agent has to stay under to fall asleep.
+		float                                       m_sleepForce;///< Steering force the agent has to stay under to fall asleep.
+		float                                       m_sleepDelay;///< Seconds the agent has to be at rest before falling asleep, zero keeps it awake.
+		bool*                                       m_wakeFlag;///< optional flag raised when the agent falls asleep or wakes up.
+		Uint32                                      m_id;///< Id of the agent, keys its random stream.
+		steer::AgentHandle                          m_handle;///< Handle of the agent in m_registry.
+		const steer::AgentRegistry*                 m_registry;///< optional registry the agent was added to, references to the agent resolve through it.
+		steer::RandomStream                         m_random;///< The agent's own random numbers - wander and the dithered summing method draw from it.
 	};
 } //end steeriously namespace
 
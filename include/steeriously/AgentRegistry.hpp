@@ -0,0 +1,133 @@
+#ifndef AGENTREGISTRY_HPP
+#define AGENTREGISTRY_HPP
+
+#include <vector>
+
+#include <steeriously/Utilities.hpp>
+
+namespace steer
+{
+    //Agent.hpp includes this file
+    class Agent;
+
+    /**
+    *\struct AgentHandle
+    *\brief Names an agent of a steer::AgentRegistry by its slot and the generation of the slot, so it outlives moves of the agent
+    * and goes stale, rather than dangling, once the agent is removed. The default handle is invalid.
+    **/
+    struct AgentHandle
+    {
+        Uint32  index;///< Slot of the agent in the registry.
+        Uint32  generation;///< Generation of the slot when the agent was added, zero for an invalid handle.
+
+        AgentHandle() : index(0), generation(0) {}
+        AgentHandle(Uint32 i, Uint32 g) : index(i), generation(g) {}
+
+        /// Returns true if the handle was handed out by a registry - it may still be stale.
+        bool isValid() const { return generation != 0; }
+
+        bool operator==(const AgentHandle& other) const { return index == other.index && generation == other.generation; }
+        bool operator!=(const AgentHandle& other) const { return !(*this == other); }
+    };
+
+    //AgentRef resolves through the registry declared below
+    class AgentRegistry;
+
+    /**
+    *\struct AgentRef
+    *\brief What a behavior steers relative to - the handle of an agent along with the steer::AgentRegistry it was handed out by,
+    * or a plain pointer to an agent that is not registered. Built from a pointer it picks up the agent's handle and registry if it
+    * has them. Once the handle is valid the pointer is never used again, so the reference resolves to null rather than dangling.
+    **/
+    struct AgentRef
+    {
+        steer::Agent*                   agent;///< The agent as it was when the reference was made, only used when the handle is invalid.
+        steer::AgentHandle              handle;///< Handle of the agent, invalid if it was not registered.
+        const steer::AgentRegistry*     registry;///< Registry the handle was handed out by, null if it is invalid.
+
+        AgentRef() : agent(nullptr), handle(), registry(nullptr) {}
+        AgentRef(steer::Agent* a);
+        AgentRef(const steer::AgentRegistry& r, steer::AgentHandle h) : agent(nullptr), handle(h), registry(&r) {}
+
+        /// Returns the agent named - through the registry when the handle is valid, null once that agent was removed.
+        inline steer::Agent* resolve() const;
+    };
+
+    /**
+        \class AgentRegistry
+        \brief Hands out generational handles to agents and resolves them back to the agents' current address.
+        <br />A removed agent's slot moves on to the next generation, so handles to it resolve to null instead of dangling, and
+        the slot is reused by the next agent added. An agent moved in memory is relocated in the registry and its handles
+        follow it, which lets steer::World compact its agents without breaking targets.
+    **/
+    class AgentRegistry
+    {
+    public:
+
+        /// Default constructor
+        AgentRegistry();
+
+        /**
+        * \fn steer::AgentHandle add(steer::Agent* agent)
+        * \brief Registers an agent and returns its handle.
+        * \param agent - a pointer to a steer::Agent.
+        **/
+        steer::AgentHandle add(steer::Agent* agent);
+
+        /**
+        * \fn void remove(steer::AgentHandle handle)
+        * \brief Unregisters an agent, its handles resolve to null from now on. Stale handles are ignored.
+        * \param handle - a steer::AgentHandle.
+        **/
+        void remove(steer::AgentHandle handle);
+
+        /**
+        * \fn void relocate(steer::AgentHandle handle, steer::Agent* agent)
+        * \brief Points a handle at the agent's new address after it was moved.
+        * \param handle - a steer::AgentHandle, still valid.
+        * \param agent - a pointer to the moved steer::Agent.
+        **/
+        void relocate(steer::AgentHandle handle, steer::Agent* agent);
+
+        /**
+        * \fn steer::Agent* resolve(steer::AgentHandle handle) const
+        * \brief Returns the agent a handle names, null if it was removed or the handle is invalid.
+        * \param handle - a steer::AgentHandle.
+        **/
+        steer::Agent* resolve(steer::AgentHandle handle) const
+        {
+            if (handle.index >= m_slots.size() || m_slots[handle.index].generation != handle.generation)
+                return nullptr;
+
+            return m_slots[handle.index].agent;
+        }
+
+        /**
+        * \fn Uint32 size() const
+        * \brief Returns the number of agents registered.
+        **/
+        Uint32 size() const { return m_size; }
+
+    private:
+
+        struct Slot
+        {
+            steer::Agent*   agent;
+            Uint32          generation;
+        };
+
+        std::vector<Slot>       m_slots;///< agent and generation of each slot, odd generations are alive.
+        std::vector<Uint32>     m_free;///< slots of removed agents, reused last removed first.
+        Uint32                  m_size;///< number of agents registered.
+    };
+
+    inline steer::Agent* AgentRef::resolve() const
+    {
+        if (handle.isValid())
+            return registry != nullptr ? registry->resolve(handle) : nullptr;
+
+        return agent;
+    }
+}
+
+#endif // AGENTREGISTRY_HPP
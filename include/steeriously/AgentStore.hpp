@@ -0,0 +1,136 @@
+#ifndef AGENTSTORE_HPP
+#define AGENTSTORE_HPP
+
+#include <vector>
+
+#include <steeriously/Utilities.hpp>
+#include <steeriously/Vector2.hpp>
+
+namespace steer
+{
+    /**
+        \class AgentStore
+        \brief Structure of arrays holding the state needed to integrate a population of agents.
+        <br />Each field lives in its own contiguous array, so integrate() streams through memory one
+        field at a time and the compiler can vectorize the loop across agents. load() gathers the state
+        of a container of agents into the arrays and store() scatters the result back.
+        <br />Vectors are held at the precision of steer::Vector2, so integrating in the store gives the same
+        result as steer::Agent::integrate in float and double builds alike.
+    **/
+    class AgentStore
+    {
+    public:
+
+        typedef steer::Vector2::value_type Scalar;///< The scalar type of steer::Vector2.
+
+        /// Default constructor
+        AgentStore();
+
+        /// Destructor
+        ~AgentStore();
+
+        /**
+        * \fn void resize(Uint32 count)
+        * \brief Sets the number of agents held by the store. New entries are zeroed with a mass of one.
+        * \param count - an Uint32.
+        **/
+        void resize(Uint32 count);
+
+        /**
+        * \fn void clear()
+        * \brief Removes every agent from the store, keeping the allocated memory.
+        **/
+        void clear();
+
+        /**
+        * \fn Uint32 size() const
+        * \brief Returns the number of agents held by the store.
+        **/
+        Uint32 size() const { return m_size; }
+
+        /**
+        * \fn void integrate(float dt)
+        * \brief Moves every agent in the store according to its steering force, the same way steer::Agent::integrate does.
+        * <br />The loop is free of branches, with GCC and Clang it vectorizes when built with -fno-math-errno -fno-trapping-math (or -ffast-math).
+        * \param dt - a plain old float.
+        **/
+        void integrate(float dt);
+
+        /**
+        * \fn void integrate(Uint32 begin, Uint32 end, float dt)
+        * \brief Moves the agents in the range [begin, end) according to their steering force.
+        * \param begin - an Uint32, index of the first agent.
+        * \param end - an Uint32, one past the index of the last agent.
+        * \param dt - a plain old float.
+        **/
+        void integrate(Uint32 begin, Uint32 end, float dt);
+
+        /**
+        * \fn template <class conT> void load(const conT& agents)
+        * \brief Resizes the store to the container and copies the state of every agent into the arrays.
+        * \param agents - a random access container of pointers to steer::Agent derived objects.
+        **/
+        template <class conT>
+        void load(const conT& agents);
+
+        /**
+        * \fn template <class conT> void load(const conT& agents, Uint32 begin, Uint32 end)
+        * \brief Copies the state of the agents in the range [begin, end) into the arrays, the store must already be sized to the container.
+        * <br />Ranges that do not overlap can be loaded from several threads at once.
+        * \param agents - a random access container of pointers to steer::Agent derived objects.
+        * \param begin - an Uint32, index of the first agent.
+        * \param end - an Uint32, one past the index of the last agent.
+        **/
+        template <class conT>
+        void load(const conT& agents, Uint32 begin, Uint32 end);
+
+        /**
+        * \fn template <class conT> void store(const conT& agents) const
+        * \brief Copies the integrated state back into the agents it was loaded from, updates their rotation, clears the external forces applied to them and moves them between cells of their partition.
+        * \param agents - the same container that was passed to load.
+        **/
+        template <class conT>
+        void store(const conT& agents) const;
+
+        /**
+        * \fn template <class conT> void store(const conT& agents, Uint32 begin, Uint32 end) const
+        * \brief Copies the integrated velocity, heading and side of the agents in the range [begin, end) back, updates their rotation and clears their external forces.
+        * <br />Nothing but the agents in the range is written, so ranges that do not overlap can be stored from several threads
+        * at once. Positions are left alone, call place() afterwards to move the agents and re-bin them in their partition.
+        * \param agents - the same container that was passed to load.
+        * \param begin - an Uint32, index of the first agent.
+        * \param end - an Uint32, one past the index of the last agent.
+        **/
+        template <class conT>
+        void store(const conT& agents, Uint32 begin, Uint32 end) const;
+
+        /**
+        * \fn template <class conT> void place(const conT& agents) const
+        * \brief Copies the integrated position back into every agent and moves it between cells of its partition. Cells are shared, so this runs on one thread.
+        * \param agents - the same container that was passed to load.
+        **/
+        template <class conT>
+        void place(const conT& agents) const;
+
+    public:
+        std::vector<Scalar>                         m_positionX;///< x component of the position of each agent.
+        std::vector<Scalar>                         m_positionY;///< y component of the position of each agent.
+        std::vector<Scalar>                         m_velocityX;///< x component of the velocity of each agent.
+        std::vector<Scalar>                         m_velocityY;///< y component of the velocity of each agent.
+        std::vector<Scalar>                         m_headingX;///< x component of the heading of each agent.
+        std::vector<Scalar>                         m_headingY;///< y component of the heading of each agent.
+        std::vector<Scalar>                         m_sideX;///< x component of the side vector of each agent.
+        std::vector<Scalar>                         m_sideY;///< y component of the side vector of each agent.
+        std::vector<Scalar>                         m_forceX;///< x component of the steering force of each agent.
+        std::vector<Scalar>                         m_forceY;///< y component of the steering force of each agent.
+        std::vector<float>                          m_mass;///< mass of each agent.
+        std::vector<float>                          m_maxSpeed;///< maximum speed of each agent.
+
+    private:
+        Uint32                                      m_size;///< number of agents held by the store.
+    };
+}
+
+#include <steeriously/AgentStore.inl>
+
+#endif // AGENTSTORE_HPP
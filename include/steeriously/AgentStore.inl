@@ -0,0 +1,79 @@
+#include <assert.h>
+
+#include <steeriously/Agent.hpp>
+#include <steeriously/VectorMath.hpp>
+
+template <class conT>
+void steer::AgentStore::load(const conT& agents)
+{
+	resize((Uint32)agents.size());
+
+	load(agents, 0, m_size);
+}
+
+template <class conT>
+void steer::AgentStore::load(const conT& agents, Uint32 begin, Uint32 end)
+{
+	assert(agents.size() == m_size && end <= m_size && "<AgentStore::load> store not sized to the container");
+
+	for (Uint32 i = begin; i < end; ++i)
+	{
+		const auto& agent = agents[i];
+
+		m_positionX[i] = agent->m_agentPosition.x;
+		m_positionY[i] = agent->m_agentPosition.y;
+		m_velocityX[i] = agent->m_velocity.x;
+		m_velocityY[i] = agent->m_velocity.y;
+		m_headingX[i] = agent->m_heading.x;
+		m_headingY[i] = agent->m_heading.y;
+		m_sideX[i] = agent->m_side.x;
+		m_sideY[i] = agent->m_side.y;
+		m_forceX[i] = agent->m_steeringForce.x + agent->m_externalForce.x;
+		m_forceY[i] = agent->m_steeringForce.y + agent->m_externalForce.y;
+		m_mass[i] = agent->m_mass;
+		m_maxSpeed[i] = agent->m_maxSpeed;
+	}
+}
+
+template <class conT>
+void steer::AgentStore::store(const conT& agents) const
+{
+	store(agents, 0, m_size);
+	place(agents);
+}
+
+template <class conT>
+void steer::AgentStore::store(const conT& agents, Uint32 begin, Uint32 end) const
+{
+	assert(agents.size() == m_size && end <= m_size && "<AgentStore::store> container does not match the one that was loaded");
+
+	for (Uint32 i = begin; i < end; ++i)
+	{
+		const auto& agent = agents[i];
+
+		agent->m_velocity = steer::Vector2(m_velocityX[i], m_velocityY[i]);
+		agent->m_heading = steer::Vector2(m_headingX[i], m_headingY[i]);
+		agent->m_side = steer::Vector2(m_sideX[i], m_sideY[i]);
+		agent->m_rotation = steer::VectorMath::findAngle(agent->m_velocity);
+		agent->m_externalForce = steer::Vector2(0.0, 0.0);
+	}
+}
+
+template <class conT>
+void steer::AgentStore::place(const conT& agents) const
+{
+	assert(agents.size() == m_size && "<AgentStore::place> container does not match the one that was loaded");
+
+	for (Uint32 i = 0; i < m_size; ++i)
+	{
+		const auto& agent = agents[i];
+
+		steer::Vector2 oldPosition = agent->m_agentPosition;
+
+		agent->m_agentPosition = steer::Vector2(m_positionX[i], m_positionY[i]);
+
+		//move the agent between cells of the partition if it
+		//crossed a cell boundary
+		agent->updateCell(oldPosition);
+	}
+}
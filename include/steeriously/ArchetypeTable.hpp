@@ -0,0 +1,134 @@
+#ifndef ARCHETYPETABLE_HPP
+#define ARCHETYPETABLE_HPP
+
+#include <vector>
+
+#include <steeriously/Utilities.hpp>
+#include <steeriously/Vector2.hpp>
+
+namespace steer
+{
+    //SuperComponent.hpp pulls in libinc.hpp, which includes this file
+    class SuperComponent;
+
+    /**
+    *\brief One behavior of a weighted sum, adding (or, for evade and wander, assigning) its weighted force to the running total.
+    **/
+    typedef void (*ArchetypeStep)(steer::SuperComponent& agent, steer::Vector2& force);
+
+    /**
+    *\struct Archetype
+    *\brief Agents sharing the same active behaviors and summing method, and the kernel they are all summed with.
+    **/
+    struct Archetype
+    {
+        Uint32                              flags;///< steer::behaviorType bits of the agents.
+        Uint32                              summingMethod;///< steer::summingMethod of the agents.
+        bool                                gatherNeighbors;///< Whether the kernel gathers the neighbors first.
+        std::vector<steer::ArchetypeStep>   steps;///< The weighted sum of the flags, empty for the other summing methods which go through Calculate.
+    };
+
+    /**
+    *\struct ArchetypeRun
+    *\brief A run of agents of the table sharing an archetype.
+    **/
+    struct ArchetypeRun
+    {
+        Uint32  archetype;///< Position of the archetype in the table.
+        Uint32  begin;///< First agent of the run.
+        Uint32  end;///< One past the last agent of the run.
+    };
+
+    /**
+        \class ArchetypeTable
+        \brief Buckets agents by their active behaviors so each bucket runs through a kernel built for its behaviors.
+        <br />The table decodes the flags once per archetype into the list of behaviors to sum (the same list
+        SuperComponent::calculateWeightedSum runs, see buildSteps), and groups the agents of an archetype into runs, so every
+        agent of a run takes the same path.
+        <br />Agents are only grouped within windows of consecutive agents. By default the window is one agent, so agents keep
+        their order and runs form from agents of an archetype created together - visiting agents out of the order they sit
+        in memory costs more than the branches saved. A window of zero groups the whole list.
+        <br />The table is only rebuilt when asked to - steer::World rebuilds it when an agent's flags or summing method
+        change (see SuperComponent::setArchetypeFlag) or agents fall asleep and wake up.
+    **/
+    class ArchetypeTable
+    {
+    public:
+
+        /**
+        * \fn ArchetypeTable()
+        * \brief Construct an empty table keeping agents in order (a window of one).
+        **/
+        ArchetypeTable();
+
+        /**
+        * \fn void setWindow(Uint32 window)
+        * \brief Sets how many consecutive agents are grouped by archetype, zero groups the whole list. Takes effect on the next rebuild.
+        * \param window - an Uint32.
+        **/
+        void setWindow(Uint32 window) { m_window = window; }
+
+        /**
+        * \fn Uint32 getWindow() const
+        * \brief Returns how many consecutive agents are grouped by archetype.
+        **/
+        Uint32 getWindow() const { return m_window; }
+
+        /**
+        * \fn void rebuild(const std::vector<steer::SuperComponent*>& agents)
+        * \brief Groups the agents of each window by their flags and summing method, keeping their order within each group.
+        * \param agents - a std::vector of pointers to steer::SuperComponent.
+        **/
+        void rebuild(const std::vector<steer::SuperComponent*>& agents);
+
+        /**
+        * \fn const std::vector<steer::SuperComponent*>& getAgents() const
+        * \brief Returns the agents of the table, in runs of the same archetype.
+        **/
+        const std::vector<steer::SuperComponent*>& getAgents() const { return m_agents; }
+
+        /**
+        * \fn const std::vector<steer::Archetype>& getArchetypes() const
+        * \brief Returns the archetypes, in the order they were first met.
+        **/
+        const std::vector<steer::Archetype>& getArchetypes() const { return m_archetypes; }
+
+        /**
+        * \fn const std::vector<steer::ArchetypeRun>& getRuns() const
+        * \brief Returns the runs of agents, in table order.
+        **/
+        const std::vector<steer::ArchetypeRun>& getRuns() const { return m_runs; }
+
+        /**
+        * \fn Uint32 runOf(Uint32 index) const
+        * \brief Returns the position of the run holding the agent at an index of the table.
+        * \param index - an Uint32, less than the number of agents.
+        **/
+        Uint32 runOf(Uint32 index) const;
+
+        /**
+        * \fn static steer::Vector2 calculate(const steer::Archetype& archetype, steer::SuperComponent& agent)
+        * \brief Computes the steering force of an agent of the archetype, same as agent.Calculate().
+        * \param archetype - a steer::Archetype.
+        * \param agent - a steer::SuperComponent with the flags and summing method of the archetype.
+        **/
+        static steer::Vector2 calculate(const steer::Archetype& archetype, steer::SuperComponent& agent);
+
+        /**
+        * \fn static void buildSteps(Uint32 flags, std::vector<steer::ArchetypeStep>& steps)
+        * \brief Decodes behavior flags into the steps of a weighted sum, in order. SuperComponent::calculateWeightedSum runs the same steps, decoded whenever its flags change.
+        * \param flags - an Uint32 of steer::behaviorType bits.
+        * \param steps - a std::vector of steer::ArchetypeStep receiving the steps.
+        **/
+        static void buildSteps(Uint32 flags, std::vector<steer::ArchetypeStep>& steps);
+
+    private:
+
+        std::vector<steer::SuperComponent*>     m_agents;///< agents in runs of the same archetype.
+        std::vector<steer::Archetype>           m_archetypes;///< archetypes, in the order they were first met.
+        std::vector<steer::ArchetypeRun>        m_runs;///< runs of agents, in table order.
+        Uint32                                  m_window;///< number of consecutive agents grouped by archetype, zero for all of them.
+    };
+}
+
+#endif // ARCHETYPETABLE_HPP
@@ -119,7 +119,36 @@ namespace steer
 
 		float MinDetectionBoxLength         = 40.f;
 
+		// Number of obstacles nearest the agent that Hide looks for a hiding spot behind when given a steer::ObstacleIndex
+		Uint32 HideCandidates               = 8;
+
 		float WallDetectionFeelerLength     = 40.f;
+
+		// An agent of a steer::World falls asleep once its speed and steering force stay under these for SleepDelay
+		// seconds, and wakes up when its target changes, a force is applied or a moving agent comes within view.
+		// A delay of zero keeps agents awake.
+		float SleepSpeed                    = 1.f;
+		float SleepForce                    = 1.f;
+		float SleepDelay                    = 0.5f;
+
+		// Probabilities that a behavior is evaluated on a given tick when dithering (summingMethod::dithered).
+		// The expected number of behaviors evaluated per agent and tick is the sum of the probabilities of the
+		// active behaviors, lower them to lower the cost of a frame.
+		float prWallAvoidance               = 0.5f;
+		float prObstacleAvoidance           = 0.5f;
+		float prSeparation                  = 0.2f;
+		float prAlignment                   = 0.3f;
+		float prCohesion                    = 0.6f;
+		float prWander                      = 0.8f;
+		float prSeek                        = 0.8f;
+		float prFlee                        = 0.6f;
+		float prEvade                       = 1.f;
+		float prArrive                      = 0.5f;
+		float prPursuit                     = 0.8f;
+		float prOffsetPursuit               = 0.8f;
+		float prInterpose                   = 0.8f;
+		float prHide                        = 0.8f;
+		float prFollowPath                  = 0.8f;
 	};
 }
 
@@ -2,6 +2,7 @@
 #define GROUPBEHAVIORHELPERS_HPP
 
 #include <vector>
+#include <steeriously/SpatialHashGrid.hpp>
 #include <steeriously/Vector2.hpp>
 
 namespace steer //namespace steeriously
@@ -18,6 +19,74 @@ namespace steer //namespace steeriously
 template <class T, class conT>
 void TagVehiclesWithinViewRange(const T& entity, const conT& neighbors, float viewDistance);
 
+/**
+   \fn  template <class T>
+        void steer::TagVehiclesWithinViewRange(const T& entity, const steer::SpatialHashGrid& grid, float viewDistance, std::vector<steer::Agent*>& neighbors);
+   \brief Template function that gathers and tags the agents within the view range of the specified agent, visiting only the cells of the grid around it.
+   <br />The agents tagged by the last call with the same vector are untagged, then the vector is cleared and only holds agents within range afterwards, so pass it to the flocking behaviors in place of the full container.
+   \param entity - a steer::Agent derived object registered with the grid.
+   \param grid - a steer::SpatialHashGrid.
+   \param viewDistance - a plain old float.
+   \param neighbors - a std::vector of steer::Agent pointers receiving the agents in range.
+**/
+template <class T>
+void TagVehiclesWithinViewRange(const T& entity, const SpatialHashGrid& grid, float viewDistance, std::vector<Agent*>& neighbors);
+
+/**
+   \fn  template <class T>
+        void steer::GatherVehiclesWithinViewRange(const T& entity, const steer::SpatialHashGrid& grid, float viewDistance, std::vector<steer::Agent*>& neighbors);
+   \brief Template function that gathers the agents within the view range of the specified agent without tagging them.
+   <br />Nothing but the neighbors vector is written, so many agents can gather at once. Pass steer::AnyNeighbor to the flocking behaviors along with the list.
+   \param entity - a steer::Agent derived object registered with the grid.
+   \param grid - a steer::SpatialHashGrid.
+   \param viewDistance - a plain old float.
+   \param neighbors - a std::vector of steer::Agent pointers receiving the agents in range.
+**/
+template <class T>
+void GatherVehiclesWithinViewRange(const T& entity, const SpatialHashGrid& grid, float viewDistance, std::vector<Agent*>& neighbors);
+
+/**
+   \fn  template <class T, class conT>
+        void steer::GatherVehiclesWithinViewRange(const T& entity, const conT& agents, float viewDistance, std::vector<steer::Agent*>& neighbors);
+   \brief Template function that gathers the agents within the view range of the specified agent in a scan over every agent, without tagging them.
+   <br />For agents without a grid. Nothing but the neighbors vector is written, so many agents can gather at once. Pass steer::AnyNeighbor to the flocking behaviors along with the list.
+   \param entity - a steer::Agent derived object.
+   \param agents - a container of pointers to steer::Agent derived objects.
+   \param viewDistance - a plain old float.
+   \param neighbors - a std::vector of steer::Agent pointers receiving the agents in range.
+**/
+template <class T, class conT>
+void GatherVehiclesWithinViewRange(const T& entity, const conT& agents, float viewDistance, std::vector<Agent*>& neighbors);
+
+/**
+   \struct TaggedInGroup
+   \brief Neighbor predicate for the flocking behaviors accepting agents tagged by TagVehiclesWithinViewRange.
+**/
+struct TaggedInGroup
+{
+    template <class N>
+    bool operator()(const N& neighbor) const { return neighbor->taggedInGroup(); }
+};
+
+/**
+   \struct AnyNeighbor
+   \brief Neighbor predicate for the flocking behaviors accepting every agent, for lists gathered by GatherVehiclesWithinViewRange.
+**/
+struct AnyNeighbor
+{
+    template <class N>
+    bool operator()(const N&) const { return true; }
+};
+
+/**
+   \fn  template <class conT>
+        void steer::PublishStates(const conT& agents);
+   \brief Template function publishing the state of every double-buffered agent in a container, see steer::Agent::setDoubleBuffered.
+   \param agents - a container of pointers to steer::Agent derived objects.
+**/
+template <class conT>
+void PublishStates(const conT& agents);
+
 /**
    \fn template <class T, class conT>
        void TagObstaclesWithinViewRange(const T& entity, const conT& obstacles, float boxLength);
@@ -1,6 +1,7 @@
 #include <iostream>
 
 #include <steeriously/Agent.hpp>
+#include <steeriously/Profiler.hpp>
 #include <steeriously/VectorMath.hpp>
 #include <steeriously/Transformations.hpp>
 
@@ -10,6 +11,75 @@ void steer::TagVehiclesWithinViewRange(const T& entity, const conT& neighbors, f
 	steer::TagNeighbors<T, conT>(entity, neighbors, viewDistance);
 }
 
+template <class T>
+void steer::TagVehiclesWithinViewRange(const T& entity, const SpatialHashGrid& grid, float viewDistance, std::vector<Agent*>& neighbors)
+{
+	//first clear the tags of the last query, as TagNeighbors does
+	for (auto& i : neighbors)
+	{
+		i->unTag();
+	}
+
+	steer::GatherVehiclesWithinViewRange<T>(entity, grid, viewDistance, neighbors);
+
+	for (auto& i : neighbors)
+	{
+		i->Tag();
+	}
+}
+
+template <class T>
+void steer::GatherVehiclesWithinViewRange(const T& entity, const SpatialHashGrid& grid, float viewDistance, std::vector<Agent*>& neighbors)
+{
+	STEERIOUSLY_PROFILE_SCOPE(steer::profile::tagNeighbors);
+
+	neighbors.clear();
+
+	if (entity == nullptr)
+		return;
+
+	//only the cells around the entity are visited and only
+	//agents within range make it into the list
+	grid.query(entity->getPosition(), viewDistance, neighbors, entity);
+}
+
+template <class T, class conT>
+void steer::GatherVehiclesWithinViewRange(const T& entity, const conT& agents, float viewDistance, std::vector<Agent*>& neighbors)
+{
+	STEERIOUSLY_PROFILE_SCOPE(steer::profile::tagNeighbors);
+
+	neighbors.clear();
+
+	if (entity == nullptr)
+		return;
+
+	//the same range check as SpatialHashGrid::query, over every agent
+	for (auto& i : agents)
+	{
+		if (i == nullptr || i == entity)
+			continue;
+
+		Vector2 to = i->getPublishedPosition() - entity->getPosition();
+
+		//the bounding radius of the other is taken into account by adding it
+		//to the range
+		float range = viewDistance + i->getBoundingRadius();
+
+		if (steer::VectorMath::lengthSquared(to) < range*range)
+			neighbors.push_back(i);
+	}
+}
+
+template <class conT>
+void steer::PublishStates(const conT& agents)
+{
+	for (auto& i : agents)
+	{
+		if (i != nullptr)
+			i->publishState();
+	}
+}
+
 template <class T, class conT>
 void steer::TagObstaclesWithinViewRange(const T& entity, const conT& obstacles, float boxLength)
 {
@@ -19,6 +89,8 @@ void steer::TagObstaclesWithinViewRange(const T& entity, const conT& obstacles,
 template <class T, class conT>
 void steer::TagNeighbors(const T& entity, const conT& neighbors, float radius)
 {
+	STEERIOUSLY_PROFILE_SCOPE(steer::profile::tagNeighbors);
+
 	//iterate through all entities checking for range
 	for (auto& i : neighbors)
 	{
@@ -47,6 +119,8 @@ void steer::TagNeighbors(const T& entity, const conT& neighbors, float radius)
 template <class T, class conT>
 void steer::TagObstacles(const T& entity, const conT& obstacles, float radius)
 {
+	STEERIOUSLY_PROFILE_SCOPE(steer::profile::tagObstacles);
+
 	//iterate through all entities checking for range
 	for (auto& i : obstacles)
 	{
@@ -0,0 +1,449 @@
+#ifndef COMPOSITION_HPP
+#define COMPOSITION_HPP
+
+#include <tuple>
+
+#include <steeriously/AgentRegistry.hpp>
+#include <steeriously/BehaviorData.hpp>
+#include <steeriously/Path.hpp>
+#include <steeriously/Steeriously.hpp>
+#include <steeriously/Utilities.hpp>
+#include <steeriously/Vector2.hpp>
+
+namespace steer
+{
+    /**
+    *\brief The behaviors steer::Steering is composed from. Each one holds its weight and whatever
+    * else it steers by (the agent pursued, the agent hidden from...), and computes its weighted
+    * force from the agent it is handed. Agents handed to them provide getParams, and the ones
+    * using obstacles or walls provide the getters steer::ComposedComponent and steer::SuperComponent
+    * share (getObstacles/getObstacleIndex, getWalls/getWallIndex). The flocking behaviors read the
+    * neighbors gathered into m_neighborhood before the force is computed.
+    * <br />A behavior of your own only needs the same members: a flag, needsNeighbors, setParams and force.
+    **/
+    namespace behaviors
+    {
+        /**
+        *\struct Seek
+        *\brief Seeks the target of the agent.
+        **/
+        struct Seek
+        {
+            static const Uint32 flag = steer::behaviorType::seek;///< behaviorType bit reported by on().
+            static const bool needsNeighbors = false;///< Whether the neighbors are gathered before the force is computed.
+
+            float weight;///< Multiplier - can be adjusted to effect strength of the behavior.
+
+            Seek() : weight(1.f) {}
+
+            /// Takes the weight from the parameters.
+            void setParams(const steer::BehaviorParameters& params) { weight = params.SeekWeight; }
+
+            /// Returns the weighted force.
+            template <class T>
+            steer::Vector2 force(const T& agent);
+        };
+
+        /**
+        *\struct Flee
+        *\brief Flees the target of the agent.
+        **/
+        struct Flee
+        {
+            static const Uint32 flag = steer::behaviorType::flee;///< behaviorType bit reported by on().
+            static const bool needsNeighbors = false;///< Whether the neighbors are gathered before the force is computed.
+
+            float weight;///< Multiplier - can be adjusted to effect strength of the behavior.
+
+            Flee() : weight(1.f) {}
+
+            /// Takes the weight from the parameters.
+            void setParams(const steer::BehaviorParameters& params) { weight = params.FleeWeight; }
+
+            /// Returns the weighted force.
+            template <class T>
+            steer::Vector2 force(const T& agent);
+        };
+
+        /**
+        *\struct Arrive
+        *\brief Arrives at the target of the agent, slowing down with the agent's m_deceleration.
+        **/
+        struct Arrive
+        {
+            static const Uint32 flag = steer::behaviorType::arrive;///< behaviorType bit reported by on().
+            static const bool needsNeighbors = false;///< Whether the neighbors are gathered before the force is computed.
+
+            float weight;///< Multiplier - can be adjusted to effect strength of the behavior.
+
+            Arrive() : weight(1.f) {}
+
+            /// Takes the weight from the parameters.
+            void setParams(const steer::BehaviorParameters& params) { weight = params.ArriveWeight; }
+
+            /// Returns the weighted force.
+            template <class T>
+            steer::Vector2 force(const T& agent);
+        };
+
+        /**
+        *\struct Pursuit
+        *\brief Pursues another agent, set in evader.
+        **/
+        struct Pursuit
+        {
+            static const Uint32 flag = steer::behaviorType::pursuit;///< behaviorType bit reported by on().
+            static const bool needsNeighbors = false;///< Whether the neighbors are gathered before the force is computed.
+
+            float           weight;///< Multiplier - can be adjusted to effect strength of the behavior.
+            steer::AgentRef evader;///< The agent pursued.
+
+            Pursuit() : weight(1.f), evader() {}
+
+            /// Takes the weight from the parameters.
+            void setParams(const steer::BehaviorParameters& params) { weight = params.PursuitWeight; }
+
+            /// Returns the weighted force.
+            template <class T>
+            steer::Vector2 force(const T& agent);
+        };
+
+        /**
+        *\struct Evade
+        *\brief Evades another agent, set in pursuer.
+        **/
+        struct Evade
+        {
+            static const Uint32 flag = steer::behaviorType::evade;///< behaviorType bit reported by on().
+            static const bool needsNeighbors = false;///< Whether the neighbors are gathered before the force is computed.
+
+            float           weight;///< Multiplier - can be adjusted to effect strength of the behavior.
+            steer::AgentRef pursuer;///< The agent evaded.
+
+            Evade() : weight(1.f), pursuer() {}
+
+            /// Takes the weight from the parameters.
+            void setParams(const steer::BehaviorParameters& params) { weight = params.EvadeWeight; }
+
+            /// Returns the weighted force.
+            template <class T>
+            steer::Vector2 force(const T& agent);
+        };
+
+        /**
+        *\struct OffsetPursuit
+        *\brief Follows a leader, set in leader, at the agent's m_offset.
+        **/
+        struct OffsetPursuit
+        {
+            static const Uint32 flag = steer::behaviorType::offsetPursuit;///< behaviorType bit reported by on().
+            static const bool needsNeighbors = false;///< Whether the neighbors are gathered before the force is computed.
+
+            float           weight;///< Multiplier - can be adjusted to effect strength of the behavior.
+            steer::AgentRef leader;///< The agent followed.
+
+            OffsetPursuit() : weight(1.f), leader() {}
+
+            /// Takes the weight from the parameters.
+            void setParams(const steer::BehaviorParameters& params) { weight = params.OffsetPursuitWeight; }
+
+            /// Returns the weighted force.
+            template <class T>
+            steer::Vector2 force(const T& agent);
+        };
+
+        /**
+        *\struct Interpose
+        *\brief Gets between two agents, set in agentA and agentB.
+        **/
+        struct Interpose
+        {
+            static const Uint32 flag = steer::behaviorType::interpose;///< behaviorType bit reported by on().
+            static const bool needsNeighbors = false;///< Whether the neighbors are gathered before the force is computed.
+
+            float           weight;///< Multiplier - can be adjusted to effect strength of the behavior.
+            steer::AgentRef agentA;///< First agent to get between.
+            steer::AgentRef agentB;///< Second agent to get between.
+
+            Interpose() : weight(1.f), agentA(), agentB() {}
+
+            /// Takes the weight from the parameters.
+            void setParams(const steer::BehaviorParameters& params) { weight = params.InterposeWeight; }
+
+            /// Returns the weighted force.
+            template <class T>
+            steer::Vector2 force(const T& agent);
+        };
+
+        /**
+        *\struct Hide
+        *\brief Hides behind the obstacles of the agent from another agent, set in hunter.
+        **/
+        struct Hide
+        {
+            static const Uint32 flag = steer::behaviorType::hide;///< behaviorType bit reported by on().
+            static const bool needsNeighbors = false;///< Whether the neighbors are gathered before the force is computed.
+
+            float           weight;///< Multiplier - can be adjusted to effect strength of the behavior.
+            steer::AgentRef hunter;///< The agent hidden from.
+
+            Hide() : weight(1.f), hunter() {}
+
+            /// Takes the weight from the parameters.
+            void setParams(const steer::BehaviorParameters& params) { weight = params.HideWeight; }
+
+            /// Returns the weighted force.
+            template <class T>
+            steer::Vector2 force(const T& agent);
+        };
+
+        /**
+        *\struct Wander
+        *\brief Wanders around, drawing from the random stream of the agent.
+        **/
+        struct Wander
+        {
+            static const Uint32 flag = steer::behaviorType::wander;///< behaviorType bit reported by on().
+            static const bool needsNeighbors = false;///< Whether the neighbors are gathered before the force is computed.
+
+            float weight;///< Multiplier - can be adjusted to effect strength of the behavior.
+
+            Wander() : weight(1.f) {}
+
+            /// Takes the weight from the parameters.
+            void setParams(const steer::BehaviorParameters& params) { weight = params.WanderWeight; }
+
+            /// Returns the weighted force.
+            template <class T>
+            steer::Vector2 force(const T& agent);
+        };
+
+        /**
+        *\struct FollowPath
+        *\brief Follows a path - either a steer::Path set in path, or shared waypoints through a cursor of its own.
+        **/
+        struct FollowPath
+        {
+            static const Uint32 flag = steer::behaviorType::followPath;///< behaviorType bit reported by on().
+            static const bool needsNeighbors = false;///< Whether the neighbors are gathered before the force is computed.
+
+            float               weight;///< Multiplier - can be adjusted to effect strength of the behavior.
+            steer::Path*        path;///< Path followed, the cursor is used when null.
+            steer::PathCursor   cursor;///< The agent's own progress along shared waypoints, see steer::PathCursor::set.
+
+            FollowPath() : weight(1.f), path(nullptr) {}
+
+            /// Takes the weight from the parameters.
+            void setParams(const steer::BehaviorParameters& params) { weight = params.FollowPathWeight; }
+
+            /// Returns the weighted force.
+            template <class T>
+            steer::Vector2 force(const T& agent);
+        };
+
+        /**
+        *\struct Separation
+        *\brief Keeps away from the neighbors of the agent.
+        **/
+        struct Separation
+        {
+            static const Uint32 flag = steer::behaviorType::separation;///< behaviorType bit reported by on().
+            static const bool needsNeighbors = true;///< Whether the neighbors are gathered before the force is computed.
+
+            float weight;///< Multiplier - can be adjusted to effect strength of the behavior.
+
+            Separation() : weight(1.f) {}
+
+            /// Takes the weight from the parameters.
+            void setParams(const steer::BehaviorParameters& params) { weight = params.SeparationWeight; }
+
+            /// Returns the weighted force.
+            template <class T>
+            steer::Vector2 force(const T& agent);
+        };
+
+        /**
+        *\struct Alignment
+        *\brief Heads the way the neighbors of the agent head.
+        **/
+        struct Alignment
+        {
+            static const Uint32 flag = steer::behaviorType::alignment;///< behaviorType bit reported by on().
+            static const bool needsNeighbors = true;///< Whether the neighbors are gathered before the force is computed.
+
+            float weight;///< Multiplier - can be adjusted to effect strength of the behavior.
+
+            Alignment() : weight(1.f) {}
+
+            /// Takes the weight from the parameters.
+            void setParams(const steer::BehaviorParameters& params) { weight = params.AlignmentWeight; }
+
+            /// Returns the weighted force.
+            template <class T>
+            steer::Vector2 force(const T& agent);
+        };
+
+        /**
+        *\struct Cohesion
+        *\brief Steers towards the center of the neighbors of the agent.
+        **/
+        struct Cohesion
+        {
+            static const Uint32 flag = steer::behaviorType::cohesion;///< behaviorType bit reported by on().
+            static const bool needsNeighbors = true;///< Whether the neighbors are gathered before the force is computed.
+
+            float weight;///< Multiplier - can be adjusted to effect strength of the behavior.
+
+            Cohesion() : weight(1.f) {}
+
+            /// Takes the weight from the parameters.
+            void setParams(const steer::BehaviorParameters& params) { weight = params.CohesionWeight; }
+
+            /// Returns the weighted force.
+            template <class T>
+            steer::Vector2 force(const T& agent);
+        };
+
+        /**
+        *\struct Flocking
+        *\brief Separation, alignment and cohesion computed in one pass over the neighbors with steer::Flocking.
+        **/
+        struct Flocking
+        {
+            static const Uint32 flag = steer::behaviorType::separation | steer::behaviorType::alignment | steer::behaviorType::cohesion;///< behaviorType bits reported by on().
+            static const bool needsNeighbors = true;///< Whether the neighbors are gathered before the force is computed.
+
+            float separationWeight;///< Multiplier of the separation force.
+            float alignmentWeight;///< Multiplier of the alignment force.
+            float cohesionWeight;///< Multiplier of the cohesion force.
+
+            Flocking() : separationWeight(1.f), alignmentWeight(1.f), cohesionWeight(1.f) {}
+
+            /// Takes the weights from the parameters.
+            void setParams(const steer::BehaviorParameters& params)
+            {
+                separationWeight = params.SeparationWeight;
+                alignmentWeight = params.AlignmentWeight;
+                cohesionWeight = params.CohesionWeight;
+            }
+
+            /// Returns the sum of the three weighted forces.
+            template <class T>
+            steer::Vector2 force(const T& agent);
+        };
+
+        /**
+        *\struct ObstacleAvoidance
+        *\brief Avoids the obstacles of the agent, through its obstacle index when it has one.
+        **/
+        struct ObstacleAvoidance
+        {
+            static const Uint32 flag = steer::behaviorType::obstacleAvoidance;///< behaviorType bit reported by on().
+            static const bool needsNeighbors = false;///< Whether the neighbors are gathered before the force is computed.
+
+            float weight;///< Multiplier - can be adjusted to effect strength of the behavior.
+
+            ObstacleAvoidance() : weight(1.f) {}
+
+            /// Takes the weight from the parameters.
+            void setParams(const steer::BehaviorParameters& params) { weight = params.ObstacleAvoidanceWeight; }
+
+            /// Returns the weighted force.
+            template <class T>
+            steer::Vector2 force(const T& agent);
+        };
+
+        /**
+        *\struct WallAvoidance
+        *\brief Avoids the walls of the agent, through its wall index when it has one.
+        **/
+        struct WallAvoidance
+        {
+            static const Uint32 flag = steer::behaviorType::wallAvoidance;///< behaviorType bit reported by on().
+            static const bool needsNeighbors = false;///< Whether the neighbors are gathered before the force is computed.
+
+            float weight;///< Multiplier - can be adjusted to effect strength of the behavior.
+
+            WallAvoidance() : weight(1.f) {}
+
+            /// Takes the weight from the parameters.
+            void setParams(const steer::BehaviorParameters& params) { weight = params.WallAvoidanceWeight; }
+
+            /// Returns the weighted force.
+            template <class T>
+            steer::Vector2 force(const T& agent);
+        };
+    }
+
+    namespace detail
+    {
+        /// The behaviorType bits of a list of behaviors.
+        template <class... Behaviors>
+        struct BehaviorFlags;
+
+        /// Whether any behavior of a list looks at neighbors.
+        template <class... Behaviors>
+        struct AnyNeedsNeighbors;
+
+        /// Position of a behavior in a list of behaviors.
+        template <class B, class... Behaviors>
+        struct BehaviorIndex;
+
+        /// Walks the behaviors of a tuple from position I to N.
+        template <std::size_t I, std::size_t N>
+        struct SteeringLoop;
+    }
+
+    /**
+        \class Steering
+        \brief A steering force composed at compile time from a list of behaviors, e.g. steer::Steering<behaviors::Seek, behaviors::Separation, behaviors::WallAvoidance>.
+        <br />The behaviors are called directly on the agent's own type, so every call can be inlined - behaviors left out of the list
+        are not compiled at all, and there are no flags to test. steer::ComposedComponent wraps one into an agent.
+    **/
+    template <class... Behaviors>
+    class Steering
+    {
+    public:
+
+        static const Uint32 flags = detail::BehaviorFlags<Behaviors...>::value;///< behaviorType bits of every behavior in the list.
+        static const bool needsNeighbors = detail::AnyNeedsNeighbors<Behaviors...>::value;///< Whether any behavior in the list looks at neighbors.
+
+        /**
+        * \fn void setParams(const steer::BehaviorParameters& params)
+        * \brief Takes the weight of every behavior from the parameters.
+        * \param params - a steer::BehaviorParameters object.
+        **/
+        void setParams(const steer::BehaviorParameters& params);
+
+        /**
+        * \fn template <class B> B& get()
+        * \brief Returns a behavior of the list, to set its weight or what it steers by.
+        **/
+        template <class B>
+        B& get();
+
+        /**
+        * \fn template <class T> steer::Vector2 weightedSum(const T& agent)
+        * \brief Sums the weighted forces of every behavior, truncated to the max force of the agent.
+        * \param agent - a pointer to a steer::Agent derived object.
+        **/
+        template <class T>
+        steer::Vector2 weightedSum(const T& agent);
+
+        /**
+        * \fn template <class T> steer::Vector2 prioritized(const T& agent)
+        * \brief Accumulates the weighted forces in the order of the list until the max force of the agent is used up, the behaviors left are not evaluated.
+        * \param agent - a pointer to a steer::Agent derived object.
+        **/
+        template <class T>
+        steer::Vector2 prioritized(const T& agent);
+
+    private:
+
+        std::tuple<Behaviors...>    m_behaviors;///< the behaviors, in order of priority.
+    };
+}
+
+#include <steeriously/Composition.inl>
+
+#endif // COMPOSITION_HPP
@@ -0,0 +1,274 @@
+#include <assert.h>
+
+#include <steeriously/VectorMath.hpp>
+
+namespace steer
+{
+    namespace detail
+    {
+        template <>
+        struct BehaviorFlags<>
+        {
+            static const Uint32 value = 0;
+        };
+
+        template <class B, class... Behaviors>
+        struct BehaviorFlags<B, Behaviors...>
+        {
+            static const Uint32 value = B::flag | BehaviorFlags<Behaviors...>::value;
+        };
+
+        template <>
+        struct AnyNeedsNeighbors<>
+        {
+            static const bool value = false;
+        };
+
+        template <class B, class... Behaviors>
+        struct AnyNeedsNeighbors<B, Behaviors...>
+        {
+            static const bool value = B::needsNeighbors || AnyNeedsNeighbors<Behaviors...>::value;
+        };
+
+        template <class B, class... Behaviors>
+        struct BehaviorIndex<B, B, Behaviors...>
+        {
+            static const std::size_t value = 0;
+        };
+
+        template <class B, class Other, class... Behaviors>
+        struct BehaviorIndex<B, Other, Behaviors...>
+        {
+            static const std::size_t value = 1 + BehaviorIndex<B, Behaviors...>::value;
+        };
+
+        template <std::size_t I, std::size_t N>
+        struct SteeringLoop
+        {
+            template <class Tuple>
+            static void setParams(Tuple& behaviors, const steer::BehaviorParameters& params)
+            {
+                std::get<I>(behaviors).setParams(params);
+                SteeringLoop<I + 1, N>::setParams(behaviors, params);
+            }
+
+            template <class Tuple, class T>
+            static void sum(Tuple& behaviors, const T& agent, steer::Vector2& force)
+            {
+                force += std::get<I>(behaviors).force(agent);
+                SteeringLoop<I + 1, N>::sum(behaviors, agent, force);
+            }
+
+            template <class Tuple, class T>
+            static void accumulate(Tuple& behaviors, const T& agent, steer::Vector2& force)
+            {
+                //same as steer::Agent::accumulateForce - once a force uses up
+                //what is left, the behaviors further down are not evaluated
+                float magnitudeRemaining = agent->getMaxForce() - VectorMath::length(force);
+
+                if (magnitudeRemaining <= 0.f)
+                    return;
+
+                steer::Vector2 forceToAdd = std::get<I>(behaviors).force(agent);
+
+                if (VectorMath::length(forceToAdd) >= magnitudeRemaining)
+                {
+                    force += VectorMath::normalize(forceToAdd) * magnitudeRemaining;
+                    return;
+                }
+
+                force += forceToAdd;
+
+                SteeringLoop<I + 1, N>::accumulate(behaviors, agent, force);
+            }
+        };
+
+        template <std::size_t N>
+        struct SteeringLoop<N, N>
+        {
+            template <class Tuple>
+            static void setParams(Tuple&, const steer::BehaviorParameters&) {}
+
+            template <class Tuple, class T>
+            static void sum(Tuple&, const T&, steer::Vector2&) {}
+
+            template <class Tuple, class T>
+            static void accumulate(Tuple&, const T&, steer::Vector2&) {}
+        };
+    }
+
+    template <class T>
+    steer::Vector2 behaviors::Seek::force(const T& agent)
+    {
+        return steer::Seek(agent) * weight;
+    }
+
+    template <class T>
+    steer::Vector2 behaviors::Flee::force(const T& agent)
+    {
+        return steer::Flee(agent) * weight;
+    }
+
+    template <class T>
+    steer::Vector2 behaviors::Arrive::force(const T& agent)
+    {
+        return steer::Arrive(agent, agent->m_deceleration) * weight;
+    }
+
+    template <class T>
+    steer::Vector2 behaviors::Pursuit::force(const T& agent)
+    {
+        steer::Agent* target = agent->resolve(evader);
+
+        assert(target && "pursuit target not assigned");
+
+        return steer::Pursuit(agent, target) * weight;
+    }
+
+    template <class T>
+    steer::Vector2 behaviors::Evade::force(const T& agent)
+    {
+        steer::Agent* target = agent->resolve(pursuer);
+
+        assert(target && "evade target not assigned");
+
+        return steer::Evade(agent, target) * weight;
+    }
+
+    template <class T>
+    steer::Vector2 behaviors::OffsetPursuit::force(const T& agent)
+    {
+        steer::Agent* target = agent->resolve(leader);
+
+        assert(target && "pursuit target not assigned");
+
+        return steer::OffsetPursuit(agent, target, *agent->getParams()) * weight;
+    }
+
+    template <class T>
+    steer::Vector2 behaviors::Interpose::force(const T& agent)
+    {
+        steer::Agent* targetA = agent->resolve(agentA);
+        steer::Agent* targetB = agent->resolve(agentB);
+
+        assert(targetA && targetB && "Interpose agents not assigned");
+
+        return steer::Interpose(agent, targetA, targetB, *agent->getParams()) * weight;
+    }
+
+    template <class T>
+    steer::Vector2 behaviors::Hide::force(const T& agent)
+    {
+        steer::Agent* target = agent->resolve(hunter);
+
+        assert(target && "Hide target not assigned");
+
+        if (agent->getObstacleIndex() != nullptr)
+            return steer::Hide(agent, target, *agent->getObstacleIndex(), *agent->getParams()) * weight;
+
+        return steer::Hide(agent, target, *agent->getObstacles(), *agent->getParams()) * weight;
+    }
+
+    template <class T>
+    steer::Vector2 behaviors::Wander::force(const T& agent)
+    {
+        return steer::Wander(agent) * weight;
+    }
+
+    template <class T>
+    steer::Vector2 behaviors::FollowPath::force(const T& agent)
+    {
+        if (path != nullptr)
+            return steer::PathFollowing(agent, path, *agent->getParams()) * weight;
+
+        return steer::PathFollowing(agent, cursor, *agent->getParams()) * weight;
+    }
+
+    template <class T>
+    steer::Vector2 behaviors::Separation::force(const T& agent)
+    {
+        return steer::Separation(agent, agent->m_neighborhood, steer::AnyNeighbor()) * weight;
+    }
+
+    template <class T>
+    steer::Vector2 behaviors::Alignment::force(const T& agent)
+    {
+        return steer::Alignment(agent, agent->m_neighborhood, steer::AnyNeighbor()) * weight;
+    }
+
+    template <class T>
+    steer::Vector2 behaviors::Cohesion::force(const T& agent)
+    {
+        return steer::Cohesion(agent, agent->m_neighborhood, steer::AnyNeighbor()) * weight;
+    }
+
+    template <class T>
+    steer::Vector2 behaviors::Flocking::force(const T& agent)
+    {
+        //one pack per thread, agents may be updated in parallel
+        static thread_local steer::NeighborPack pack;
+
+        steer::FlockingForces flock = steer::Flocking(agent, agent->m_neighborhood, pack, steer::AnyNeighbor());
+
+        return flock.separation * separationWeight + flock.alignment * alignmentWeight + flock.cohesion * cohesionWeight;
+    }
+
+    template <class T>
+    steer::Vector2 behaviors::ObstacleAvoidance::force(const T& agent)
+    {
+        if (agent->getObstacleIndex() != nullptr)
+            return steer::ObstacleAvoidance(agent, *agent->getObstacleIndex(), *agent->getParams()) * weight;
+
+        return steer::ObstacleAvoidance(agent, *agent->getObstacles(), *agent->getParams()) * weight;
+    }
+
+    template <class T>
+    steer::Vector2 behaviors::WallAvoidance::force(const T& agent)
+    {
+        if (agent->getWallIndex() != nullptr)
+            return steer::WallAvoidance(agent, *agent->getWallIndex()) * weight;
+
+        return steer::WallAvoidance(agent, *agent->getWalls()) * weight;
+    }
+
+    template <class... Behaviors>
+    const Uint32 Steering<Behaviors...>::flags;
+
+    template <class... Behaviors>
+    const bool Steering<Behaviors...>::needsNeighbors;
+
+    template <class... Behaviors>
+    void Steering<Behaviors...>::setParams(const steer::BehaviorParameters& params)
+    {
+        detail::SteeringLoop<0, sizeof...(Behaviors)>::setParams(m_behaviors, params);
+    }
+
+    template <class... Behaviors>
+    template <class B>
+    B& Steering<Behaviors...>::get()
+    {
+        return std::get< detail::BehaviorIndex<B, Behaviors...>::value >(m_behaviors);
+    }
+
+    template <class... Behaviors>
+    template <class T>
+    steer::Vector2 Steering<Behaviors...>::weightedSum(const T& agent)
+    {
+        steer::Vector2 force(0.0, 0.0);
+
+        detail::SteeringLoop<0, sizeof...(Behaviors)>::sum(m_behaviors, agent, force);
+
+        return steer::VectorMath::truncate(force, agent->getMaxForce());
+    }
+
+    template <class... Behaviors>
+    template <class T>
+    steer::Vector2 Steering<Behaviors...>::prioritized(const T& agent)
+    {
+        steer::Vector2 force(0.0, 0.0);
+
+        detail::SteeringLoop<0, sizeof...(Behaviors)>::accumulate(m_behaviors, agent, force);
+
+        return force;
+    }
+}
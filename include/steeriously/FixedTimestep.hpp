@@ -0,0 +1,123 @@
+#ifndef FIXEDTIMESTEP_HPP
+#define FIXEDTIMESTEP_HPP
+
+#include <vector>
+
+#include <steeriously/Agent.hpp>
+#include <steeriously/AgentRegistry.hpp>
+#include <steeriously/Utilities.hpp>
+#include <steeriously/Vector2.hpp>
+
+namespace steer
+{
+    //World.hpp pulls in SuperComponent.hpp, which pulls in libinc.hpp, which includes this file
+    class World;
+
+    /**
+        \class FixedTimestep
+        \brief Steps a steer::World at a fixed rate, whatever the frame time, and interpolates the agents for drawing.
+        <br />advance() adds the frame time to an accumulator and calls World::step with the fixed step as many times as
+        it fits, so steering always sees the same dt - run it at 20Hz and draw at 60Hz, the behaviors work the same as on
+        a fast machine. A slow frame runs at most getMaxSteps() steps and drops the rest of its time, so the simulation
+        slows down rather than falling further and further behind.
+        <br />The time left in the accumulator lies between the last two steps - getPosition and getHeading blend each
+        agent's state before and after the last step by getAlpha(), so agents move smoothly between steps. Drawing
+        lags a step behind the simulation in exchange.
+    **/
+    class FixedTimestep
+    {
+    public:
+
+        /**
+        * \fn FixedTimestep(steer::World& world, float rate = 20.f)
+        * \brief Construct a driver stepping a world at a number of steps per second.
+        * \param world - a steer::World, must outlive the driver.
+        * \param rate - a plain old float, steps per second.
+        **/
+        FixedTimestep(steer::World& world, float rate = 20.f);
+
+        /**
+        * \fn void setRate(float rate)
+        * \brief Sets the number of steps per second, the time already accumulated is kept.
+        * \param rate - a plain old float, greater than zero.
+        **/
+        void setRate(float rate);
+
+        /**
+        * \fn float getStep() const
+        * \brief Returns the dt every World::step is called with, one over the rate.
+        **/
+        float getStep() const { return m_step; }
+
+        /**
+        * \fn void setMaxSteps(Uint32 steps)
+        * \brief Sets the most steps a single advance() runs, the rest of the frame time is dropped.
+        * \param steps - an Uint32, at least one.
+        **/
+        void setMaxSteps(Uint32 steps) { m_maxSteps = MaxOf(steps, (Uint32)1); }
+
+        /**
+        * \fn Uint32 getMaxSteps() const
+        * \brief Returns the most steps a single advance() runs.
+        **/
+        Uint32 getMaxSteps() const { return m_maxSteps; }
+
+        /**
+        * \fn Uint32 advance(float frameTime)
+        * \brief Adds the frame time to the accumulator and steps the world while a whole step fits. Returns the number of steps taken.
+        * \param frameTime - a plain old float, seconds since the last call.
+        **/
+        Uint32 advance(float frameTime);
+
+        /**
+        * \fn float getAlpha() const
+        * \brief Returns how far the time left in the accumulator lies between the last step and the next one, from zero to one.
+        **/
+        float getAlpha() const { return m_accumulator / m_step; }
+
+        /**
+        * \fn steer::Vector2 getPosition(const steer::Agent& agent) const
+        * \brief Returns the position of an agent of the world blended between the last two steps, its position if it joined since.
+        * \param agent - a steer::Agent.
+        **/
+        steer::Vector2 getPosition(const steer::Agent& agent) const;
+
+        /**
+        * \fn steer::Vector2 getHeading(const steer::Agent& agent) const
+        * \brief Returns the heading of an agent of the world blended between the last two steps, normalized.
+        * \param agent - a steer::Agent.
+        **/
+        steer::Vector2 getHeading(const steer::Agent& agent) const;
+
+        /**
+        * \fn void snap()
+        * \brief Forgets the state before the last step, e.g. after moving agents by hand, so they are drawn where they are.
+        **/
+        void snap();
+
+    private:
+
+        /**
+        * \struct Snapshot
+        * \brief The state of an agent before the last step, filed under the slot of its handle.
+        **/
+        struct Snapshot
+        {
+            Uint32          generation;///< Generation of the handle of the agent, zero if the slot holds nobody.
+            steer::Vector2  position;///< Position of the agent before the last step.
+            steer::Vector2  heading;///< Heading of the agent before the last step.
+        };
+
+        void capture();
+
+        const Snapshot* find(const steer::Agent& agent) const;
+
+        steer::World&               m_world;///< the world stepped.
+        std::vector<Snapshot>       m_previous;///< state of the agents before the last step, indexed by their handle.
+        float                       m_step;///< dt of every step.
+        float                       m_accumulator;///< time not stepped yet, less than a step.
+        Uint32                      m_maxSteps;///< most steps run by an advance.
+    };
+}
+
+#endif // FIXEDTIMESTEP_HPP
@@ -0,0 +1,91 @@
+#ifndef FLOCKINGKERNEL_HPP
+#define FLOCKINGKERNEL_HPP
+
+#include <vector>
+
+#include <steeriously/Utilities.hpp>
+#include <steeriously/Vector2.hpp>
+
+namespace steer
+{
+    /**
+    *\struct FlockingForces
+    *\brief The separation, alignment and cohesion forces computed together by steer::Flocking.
+    **/
+    struct FlockingForces
+    {
+        steer::Vector2  separation;///< Same as steer::Separation returns.
+        steer::Vector2  alignment;///< Same as steer::Alignment returns.
+        steer::Vector2  cohesion;///< Same as steer::Cohesion returns.
+    };
+
+    /**
+        \class NeighborPack
+        \brief The offsets and headings of an agent's neighbors packed into flat float arrays for the flocking kernel.
+        <br />Offsets are stored relative to the agent, which keeps float precision far from the origin.
+        Keep one pack around (one per thread when updating agents in parallel) so its arrays are only allocated once.
+    **/
+    class NeighborPack
+    {
+    public:
+
+        /**
+        * \fn void clear()
+        * \brief Empties the pack, keeping the allocated memory.
+        **/
+        void clear()
+        {
+            m_offsetX.clear();
+            m_offsetY.clear();
+            m_headingX.clear();
+            m_headingY.clear();
+        }
+
+        /**
+        * \fn void add(steer::Vector2 offset, steer::Vector2 heading)
+        * \brief Adds a neighbor.
+        * \param offset - a steer::Vector2, position of the neighbor minus position of the agent.
+        * \param heading - a steer::Vector2, heading of the neighbor.
+        **/
+        void add(steer::Vector2 offset, steer::Vector2 heading)
+        {
+            m_offsetX.push_back((float)offset.x);
+            m_offsetY.push_back((float)offset.y);
+            m_headingX.push_back((float)heading.x);
+            m_headingY.push_back((float)heading.y);
+        }
+
+        /**
+        * \fn Uint32 size() const
+        * \brief Returns the number of neighbors in the pack.
+        **/
+        Uint32 size() const { return (Uint32)m_offsetX.size(); }
+
+    public:
+        std::vector<float>      m_offsetX;///< x component of the offset of each neighbor from the agent.
+        std::vector<float>      m_offsetY;///< y component of the offset of each neighbor from the agent.
+        std::vector<float>      m_headingX;///< x component of the heading of each neighbor.
+        std::vector<float>      m_headingY;///< y component of the heading of each neighbor.
+    };
+
+    /**
+    *\struct FlockingSums
+    *\brief Raw sums over a steer::NeighborPack, turned into forces by steer::Flocking.
+    **/
+    struct FlockingSums
+    {
+        steer::Vector2  separation;///< Sum of -offset / |offset|^2 - the normalized offset divided by the distance, without a sqrt.
+        steer::Vector2  heading;///< Sum of the headings.
+        steer::Vector2  offset;///< Sum of the offsets.
+    };
+
+    /**
+    * \fn steer::FlockingSums SumNeighborPack(const steer::NeighborPack& pack)
+    * \brief Sums everything the three flocking behaviors need in one pass over the pack.
+    * <br />Uses AVX2 or SSE when the library is built with them enabled, with a scalar loop for the remainder and other targets.
+    * \param pack - a steer::NeighborPack.
+    **/
+    steer::FlockingSums SumNeighborPack(const steer::NeighborPack& pack);
+}
+
+#endif // FLOCKINGKERNEL_HPP
@@ -1,3 +1,7 @@
+#ifndef GEOMETRYHELPERS_HPP
+#define GEOMETRYHELPERS_HPP
+
+#include <steeriously/Utilities.hpp>
 #include <steeriously/VectorMath.hpp>
 
 namespace steer
@@ -16,12 +20,33 @@ namespace steer
 bool LineIntersection2D(steer::Vector2 A, steer::Vector2 B, steer::Vector2 C, steer::Vector2 D, float& dist, steer::Vector2& point);
 
 /**
-* \fn void WrapAround(steer::Vector2 &pos, int MaxX, int MaxY);
-* \brief Calculates the vector useful for wrapping around the steering vector of an agent to fit in the bounds of a rectangle (the screen, for example).
-* \param pos - a 2D vector of floats.
-* \param MaxX - a plain old int.
-* \param MaxY - a plain old int.
+*\struct RayHit
+*\brief The nearest segment a ray hits, filled in by steer::RaySegmentsIntersection.
+**/
+struct RayHit
+{
+    Uint32          index;///< Index of the segment that was hit, use it to look up the normal of the wall.
+    float           t;///< How far along the ray the hit is, between zero (the start) and one (the end).
+    float           distance;///< Distance from the start of the ray to the hit, same as steer::LineIntersection2D returns.
+    steer::Vector2  point;///< Where the ray hits the segment.
+};
+
+/**
+* \fn bool RaySegmentsIntersection(steer::Vector2 A, steer::Vector2 B, const float* fromX, const float* fromY, const float* toX, const float* toY, Uint32 count, steer::RayHit& hit)
+* \brief Intersects the ray A-B with a batch of segments stored as flat arrays of end points and finds the nearest hit.
+* <br />Hits are compared by how far along the ray they are, the distance (and its sqrt) is only worked out for the nearest.
+* Of segments hit at the same point along the ray, the first in the arrays wins. Uses AVX2 or SSE when the library is built with them enabled.
+* \param A - a 2D vector of floats, start of the ray.
+* \param B - a 2D vector of floats, end of the ray.
+* \param fromX - x of the start of each segment.
+* \param fromY - y of the start of each segment.
+* \param toX - x of the end of each segment.
+* \param toY - y of the end of each segment.
+* \param count - an Uint32, the number of segments.
+* \param hit - a steer::RayHit, only written when a segment was hit.
 **/
-void WrapAround(steer::Vector2 &pos, int MaxX, int MaxY);
+bool RaySegmentsIntersection(steer::Vector2 A, steer::Vector2 B, const float* fromX, const float* fromY, const float* toX, const float* toY, Uint32 count, steer::RayHit& hit);
 
 }//namespace steer
+
+#endif // GEOMETRYHELPERS_HPP
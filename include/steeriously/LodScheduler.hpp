@@ -0,0 +1,112 @@
+#ifndef LODSCHEDULER_HPP
+#define LODSCHEDULER_HPP
+
+#include <unordered_map>
+#include <vector>
+
+#include <steeriously/Agent.hpp>
+#include <steeriously/Utilities.hpp>
+#include <steeriously/Vector2.hpp>
+
+namespace steer
+{
+    /**
+    *\struct LodTier
+    *\brief A level of detail: agents within maxDistance of a focus point recompute their steering force every interval ticks.
+    **/
+    struct LodTier
+    {
+        float   maxDistance;///< Agents closer than this to the nearest focus point fall into the tier.
+        Uint32  interval;///< Number of ticks between two steering computations, one updates every tick.
+    };
+
+    /**
+        \class LodScheduler
+        \brief Decides which agents recompute their steering force on a tick.
+        <br />Agents are put into tiers by their distance to the nearest focus point (the camera, the player...) or
+        by a priority set for them. Agents of a lower tier only run Calculate every Nth tick and keep integrating
+        with their last steering force in between, so far away crowds cost a fraction of a full update.
+        <br />Agents of a tier are spread over its interval by their id, so the work is the same on every tick.
+    **/
+    class LodScheduler
+    {
+    public:
+
+        /**
+        * \fn LodScheduler()
+        * \brief Construct a scheduler with a single tier that updates every agent on every tick.
+        **/
+        LodScheduler();
+
+        /**
+        * \fn void setTiers(const std::vector<steer::LodTier>& tiers)
+        * \brief Sets the tiers, sorted by distance on the way in. Agents further away than the last tier fall into the last tier.
+        * \param tiers - a std::vector of steer::LodTier, must not be empty.
+        **/
+        void setTiers(const std::vector<steer::LodTier>& tiers);
+
+        /**
+        * \fn const std::vector<steer::LodTier>& getTiers() const
+        * \brief Returns the tiers, nearest first.
+        **/
+        const std::vector<steer::LodTier>& getTiers() const { return m_tiers; }
+
+        /**
+        * \fn void setFocus(steer::Vector2 focus)
+        * \brief Replaces the focus points with a single one.
+        * \param focus - a steer::Vector2.
+        **/
+        void setFocus(steer::Vector2 focus);
+
+        /**
+        * \fn void addFocus(steer::Vector2 focus)
+        * \brief Adds a focus point, agents are put into tiers by the nearest one.
+        * \param focus - a steer::Vector2.
+        **/
+        void addFocus(steer::Vector2 focus) { m_focus.push_back(focus); }
+
+        /**
+        * \fn void clearFocus()
+        * \brief Removes every focus point, agents without a priority then fall into the first tier.
+        **/
+        void clearFocus() { m_focus.clear(); }
+
+        /**
+        * \fn void setPriority(const steer::Agent* agent, Uint32 tier)
+        * \brief Puts an agent into a tier regardless of where it is - tier zero keeps the agent fully updated.
+        * \param agent - a pointer to a steer::Agent.
+        * \param tier - an Uint32, clamped to the last tier.
+        **/
+        void setPriority(const steer::Agent* agent, Uint32 tier) { m_priorities[agent->getId()] = tier; }
+
+        /**
+        * \fn void clearPriority(const steer::Agent* agent)
+        * \brief Lets the distance to the focus points pick the tier of an agent again.
+        * \param agent - a pointer to a steer::Agent.
+        **/
+        void clearPriority(const steer::Agent* agent) { m_priorities.erase(agent->getId()); }
+
+        /**
+        * \fn Uint32 tierOf(const steer::Agent& agent) const
+        * \brief Returns the index of the tier an agent falls into.
+        * \param agent - a steer::Agent.
+        **/
+        Uint32 tierOf(const steer::Agent& agent) const;
+
+        /**
+        * \fn bool isDue(const steer::Agent& agent, Uint64 tick) const
+        * \brief Returns true if the agent should recompute its steering force on the tick.
+        * \param agent - a steer::Agent.
+        * \param tick - an Uint64.
+        **/
+        bool isDue(const steer::Agent& agent, Uint64 tick) const;
+
+    private:
+
+        std::vector<steer::LodTier>                         m_tiers;///< Tiers sorted by distance, nearest first.
+        std::vector<steer::Vector2>                         m_focus;///< Points agents are measured from.
+        std::unordered_map<Uint32, Uint32>                  m_priorities;///< Tiers of the agents put into a tier by hand, by agent id so agents may move in memory.
+    };
+}
+
+#endif // LODSCHEDULER_HPP
@@ -0,0 +1,121 @@
+#ifndef OBJECTPOOL_HPP
+#define OBJECTPOOL_HPP
+
+#include <vector>
+
+#include <steeriously/Utilities.hpp>
+
+namespace steer
+{
+    /**
+        \class ObjectPool
+        \brief Typed arena handing out objects of type T from chunks of slots, reusing the slots of destroyed objects.
+        <br />Memory is allocated a chunk at a time and never moves, so objects keep their address for as long as they
+        live and each slot has a stable index (see indexOf and at). Slots are handed out lowest index first, so objects
+        created together sit next to each other in memory, and a destroyed object's slot is the next one reused.
+        <br />Once the pool has grown to the largest number of objects alive at once, create and destroy allocate nothing -
+        call reserve up front to get there from the start.
+    **/
+    template <class T>
+    class ObjectPool
+    {
+    public:
+
+        /**
+        * \fn ObjectPool(Uint32 chunkSize = 256)
+        * \brief Construct an empty pool, allocating nothing until the first object is created.
+        * \param chunkSize - an Uint32, the number of objects allocated at a time.
+        **/
+        ObjectPool(Uint32 chunkSize = 256);
+
+        /// Destructor - destroys the objects still alive and frees every chunk.
+        ~ObjectPool();
+
+        /**
+        * \fn template <class... Args> T* create(Args&&... args)
+        * \brief Constructs an object in a free slot, growing the pool by a chunk when there is none.
+        * \param args - the arguments passed on to the constructor of T.
+        **/
+        template <class... Args>
+        T* create(Args&&... args);
+
+        /**
+        * \fn void destroy(T* object)
+        * \brief Destroys an object created by the pool and frees its slot for the next create.
+        * \param object - a pointer to a T created by this pool.
+        **/
+        void destroy(T* object);
+
+        /**
+        * \fn bool owns(const T* object) const
+        * \brief Returns true if the object sits in one of the pool's slots, whether or not it is alive. Logarithmic in the number of chunks.
+        * \param object - a pointer to a T.
+        **/
+        bool owns(const T* object) const;
+
+        /**
+        * \fn Uint32 indexOf(const T* object) const
+        * \brief Returns the stable index of the slot holding an object of the pool.
+        * \param object - a pointer to a T owned by this pool.
+        **/
+        Uint32 indexOf(const T* object) const;
+
+        /**
+        * \fn T* at(Uint32 index)
+        * \brief Returns the object living in a slot, null if the slot is free or out of range.
+        * \param index - an Uint32.
+        **/
+        T* at(Uint32 index);
+
+        /**
+        * \fn void swap(steer::ObjectPool<T>& other)
+        * \brief Exchanges the objects and slots of two pools, objects keep their address.
+        * \param other - a steer::ObjectPool of the same type.
+        **/
+        void swap(steer::ObjectPool<T>& other);
+
+        /**
+        * \fn void reserve(Uint32 count)
+        * \brief Grows the pool by whole chunks until it holds at least count slots.
+        * \param count - an Uint32.
+        **/
+        void reserve(Uint32 count);
+
+        /**
+        * \fn Uint32 size() const
+        * \brief Returns the number of objects alive in the pool.
+        **/
+        Uint32 size() const { return m_size; }
+
+        /**
+        * \fn Uint32 capacity() const
+        * \brief Returns the number of slots allocated so far.
+        **/
+        Uint32 capacity() const { return (Uint32)m_chunks.size() * m_chunkSize; }
+
+    private:
+
+        //objects hand out their address, so the pool is not copyable
+        ObjectPool(const ObjectPool&);
+        ObjectPool& operator=(const ObjectPool&);
+
+        //T may still be incomplete where the pool is declared, slots
+        //are only sized in the member functions
+        T* slot(Uint32 index) const;
+
+        Uint32 chunkOf(const T* object) const;
+
+        void grow();
+
+        std::vector<unsigned char*> m_chunks;///< chunks of m_chunkSize slots, never moved once allocated.
+        std::vector<Uint32>         m_sorted;///< indices of the chunks in order of address, owns and indexOf binary search them.
+        std::vector<Uint32>         m_free;///< indices of the free slots, the back one is handed out next.
+        std::vector<bool>           m_alive;///< whether each slot holds a live object.
+        Uint32                      m_chunkSize;///< number of slots per chunk.
+        Uint32                      m_size;///< number of live objects.
+    };
+}
+
+#include <steeriously/ObjectPool.inl>
+
+#endif // OBJECTPOOL_HPP
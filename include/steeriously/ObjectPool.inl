@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <assert.h>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <class T>
+steer::ObjectPool<T>::ObjectPool(Uint32 chunkSize)
+: m_chunkSize(chunkSize > 0 ? chunkSize : 1)
+, m_size(0)
+{
+
+}
+
+template <class T>
+steer::ObjectPool<T>::~ObjectPool()
+{
+	for (Uint32 i = 0; i < (Uint32)m_alive.size(); ++i)
+	{
+		if (m_alive[i])
+			slot(i)->~T();
+	}
+
+	for (auto& chunk : m_chunks)
+		::operator delete(chunk);
+}
+
+template <class T>
+template <class... Args>
+T* steer::ObjectPool<T>::create(Args&&... args)
+{
+	if (m_free.empty())
+		grow();
+
+	Uint32 index = m_free.back();
+	m_free.pop_back();
+
+	T* object = new (slot(index)) T(std::forward<Args>(args)...);
+
+	m_alive[index] = true;
+	++m_size;
+
+	return object;
+}
+
+template <class T>
+void steer::ObjectPool<T>::destroy(T* object)
+{
+	Uint32 index = indexOf(object);
+
+	assert(m_alive[index] && "<ObjectPool::destroy> object destroyed twice");
+
+	object->~T();
+
+	//m_free has room for every slot, this never allocates
+	m_alive[index] = false;
+	m_free.push_back(index);
+	--m_size;
+}
+
+template <class T>
+bool steer::ObjectPool<T>::owns(const T* object) const
+{
+	return chunkOf(object) < m_chunks.size();
+}
+
+template <class T>
+steer::Uint32 steer::ObjectPool<T>::indexOf(const T* object) const
+{
+	Uint32 c = chunkOf(object);
+
+	assert(c < m_chunks.size() && "<ObjectPool::indexOf> object not owned by the pool");
+
+	const unsigned char* address = reinterpret_cast<const unsigned char*>(object);
+
+	return c * m_chunkSize + (Uint32)((address - m_chunks[c]) / sizeof(T));
+}
+
+template <class T>
+T* steer::ObjectPool<T>::at(Uint32 index)
+{
+	if (index >= (Uint32)m_alive.size() || !m_alive[index])
+		return nullptr;
+
+	return slot(index);
+}
+
+template <class T>
+void steer::ObjectPool<T>::swap(ObjectPool<T>& other)
+{
+	m_chunks.swap(other.m_chunks);
+	m_sorted.swap(other.m_sorted);
+	m_free.swap(other.m_free);
+	m_alive.swap(other.m_alive);
+	std::swap(m_chunkSize, other.m_chunkSize);
+	std::swap(m_size, other.m_size);
+}
+
+template <class T>
+void steer::ObjectPool<T>::reserve(Uint32 count)
+{
+	while (capacity() < count)
+		grow();
+}
+
+template <class T>
+T* steer::ObjectPool<T>::slot(Uint32 index) const
+{
+	return reinterpret_cast<T*>(m_chunks[index / m_chunkSize] + (index % m_chunkSize) * sizeof(T));
+}
+
+template <class T>
+steer::Uint32 steer::ObjectPool<T>::chunkOf(const T* object) const
+{
+	//std::less gives a total order over pointers into unrelated chunks
+	std::less<const unsigned char*> less;
+	const unsigned char* address = reinterpret_cast<const unsigned char*>(object);
+
+	//the last chunk starting at or before the address is the only one
+	//that may hold it
+	auto it = std::upper_bound(m_sorted.begin(), m_sorted.end(), address, [this, &less](const unsigned char* a, Uint32 c)
+	{
+		return less(a, m_chunks[c]);
+	});
+
+	if (it == m_sorted.begin())
+		return (Uint32)m_chunks.size();
+
+	Uint32 c = *(it - 1);
+
+	if (less(address, m_chunks[c] + m_chunkSize * sizeof(T)))
+		return c;
+
+	return (Uint32)m_chunks.size();
+}
+
+template <class T>
+void steer::ObjectPool<T>::grow()
+{
+	static_assert(std::alignment_of<T>::value <= std::alignment_of<std::max_align_t>::value, "<ObjectPool> over-aligned types are not supported");
+
+	Uint32 first = capacity();
+
+	//operator new returns memory aligned for any fundamental type, and
+	//sizeof(T) is a multiple of its alignment, so every slot is aligned
+	m_chunks.push_back(static_cast<unsigned char*>(::operator new(m_chunkSize * sizeof(T))));
+
+	//keep the chunks sorted by address for chunkOf
+	std::less<const unsigned char*> less;
+	Uint32 chunk = (Uint32)m_chunks.size() - 1;
+
+	m_sorted.insert(std::upper_bound(m_sorted.begin(), m_sorted.end(), chunk, [this, &less](Uint32 a, Uint32 b)
+	{
+		return less(m_chunks[a], m_chunks[b]);
+	}), chunk);
+
+	m_alive.resize(capacity(), false);
+	m_free.reserve(capacity());
+
+	//pushed backwards so the lowest index is handed out first
+	for (Uint32 i = capacity(); i > first; --i)
+		m_free.push_back(i - 1);
+}
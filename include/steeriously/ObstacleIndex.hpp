@@ -0,0 +1,110 @@
+#ifndef OBSTACLEINDEX_HPP
+#define OBSTACLEINDEX_HPP
+
+#include <vector>
+
+#include <steeriously/Utilities.hpp>
+#include <steeriously/Vector2.hpp>
+#include <steeriously/SphereObstacle.hpp>
+
+namespace steer
+{
+    /**
+        \class ObstacleIndex
+        \brief A bounding volume hierarchy over the circle bounds of static steer::SphereObstacle's.
+        <br />Build it once from the obstacles of a level and pass it to steer::ObstacleAvoidance and steer::Hide
+        in place of the obstacle container, so an agent only looks at the obstacles near its detection box
+        or near itself instead of every obstacle in the level.
+        <br />The positions and radii are copied when the index is built - call build again after moving an obstacle.
+    **/
+    class ObstacleIndex
+    {
+    public:
+
+        /**
+        * \fn ObstacleIndex()
+        * \brief Construct an empty index.
+        **/
+        ObstacleIndex();
+
+        /**
+        * \fn ObstacleIndex(const std::vector<steer::SphereObstacle*>& obstacles)
+        * \brief Construct an index over the obstacles.
+        * \param obstacles - a std::vector of steer::SphereObstacle pointers, which must outlive the index.
+        **/
+        explicit ObstacleIndex(const std::vector<steer::SphereObstacle*>& obstacles);
+
+        /**
+        * \fn void build(const std::vector<steer::SphereObstacle*>& obstacles)
+        * \brief Rebuilds the index over the obstacles, null pointers are skipped.
+        * \param obstacles - a std::vector of steer::SphereObstacle pointers, which must outlive the index.
+        **/
+        void build(const std::vector<steer::SphereObstacle*>& obstacles);
+
+        /**
+        * \fn void query(steer::Vector2 min, steer::Vector2 max, std::vector<steer::SphereObstacle*>& result) const
+        * \brief Appends every obstacle whose circle bounds overlap the axis aligned box to result.
+        * \param min - a steer::Vector2, the smallest corner of the box.
+        * \param max - a steer::Vector2, the largest corner of the box.
+        * \param result - a std::vector of steer::SphereObstacle pointers.
+        **/
+        void query(steer::Vector2 min, steer::Vector2 max, std::vector<steer::SphereObstacle*>& result) const;
+
+        /**
+        * \fn void nearest(steer::Vector2 position, Uint32 k, std::vector<steer::SphereObstacle*>& result) const
+        * \brief Appends the k obstacles with the edge closest to the position to result, nearest first.
+        * \param position - a steer::Vector2.
+        * \param k - an Uint32, the number of obstacles wanted.
+        * \param result - a std::vector of steer::SphereObstacle pointers.
+        **/
+        void nearest(steer::Vector2 position, Uint32 k, std::vector<steer::SphereObstacle*>& result) const;
+
+        /**
+        * \fn Uint32 size() const
+        * \brief Returns the number of obstacles in the index.
+        **/
+        Uint32 size() const { return (Uint32)m_obstacles.size(); }
+
+        /**
+        * \fn bool empty() const
+        * \brief Returns true if the index holds no obstacles.
+        **/
+        bool empty() const { return m_obstacles.empty(); }
+
+    private:
+
+        /**
+        * \struct Node
+        * \brief The bounds of a subtree. Leaves hold count obstacles starting at first,
+        * inner nodes have count zero and their second child at first (the first child follows the node).
+        **/
+        struct Node
+        {
+            float   minX;
+            float   minY;
+            float   maxX;
+            float   maxY;
+            Uint32  first;
+            Uint32  count;
+        };
+
+        /**
+        * \struct Item
+        * \brief The copied bounds of an obstacle.
+        **/
+        struct Item
+        {
+            float                   x;
+            float                   y;
+            float                   radius;
+            steer::SphereObstacle*  obstacle;
+        };
+
+        Uint32 buildNode(Uint32 begin, Uint32 end);
+
+        std::vector<Node>   m_nodes;///< Nodes of the tree in depth first order, the root first.
+        std::vector<Item>   m_obstacles;///< Obstacles sorted so that every leaf references a contiguous run.
+    };
+}
+
+#endif // OBSTACLEINDEX_HPP
@@ -2,16 +2,204 @@
 #define PATH_HPP
 
 #include <list>
+#include <memory>
 #include <vector>
 #include <cassert>
 
+#include <steeriously/Utilities.hpp>
 #include <steeriously/Vector2.hpp>
 
 namespace steer
 {
+    /**
+        \class PathData
+        \brief The waypoints of a path, immutable once constructed.
+        <br />Any number of agents can follow the same path data at once, each with its own steer::PathCursor,
+        so a patrol route walked by thousands of agents is stored once and can be followed from several threads.
+    **/
+    class PathData
+    {
+        public:
+
+            /**
+            * \fn PathData()
+            * \brief Default constructor, a path without waypoints.
+            **/
+            PathData() : m_looped(false) {}
+
+            /**
+            * \fn PathData(const std::vector<steer::Vector2>& waypoints, bool looped = false)
+            * \brief Constructor used for creating path data from a vector of waypoints.
+            * \param waypoints - a std::vector of steer::Vector2.
+            * \param looped - a plain old bool, cursors set to the path meet the first waypoint after the last by default.
+            **/
+            explicit PathData(const std::vector<steer::Vector2>& waypoints, bool looped = false)
+            : m_wayPoints(waypoints)
+            , m_looped(looped)
+            {
+            }
+
+            /**
+            * \fn PathData(std::vector<steer::Vector2>&& waypoints, bool looped = false)
+            * \brief Constructor taking over a vector of waypoints.
+            * \param waypoints - a std::vector of steer::Vector2.
+            * \param looped - a plain old bool, cursors set to the path meet the first waypoint after the last by default.
+            **/
+            explicit PathData(std::vector<steer::Vector2>&& waypoints, bool looped = false)
+            : m_wayPoints(std::move(waypoints))
+            , m_looped(looped)
+            {
+            }
+
+            /**
+            * \fn const std::vector<steer::Vector2>& getWaypoints() const
+            * \brief Returns the waypoints.
+            **/
+            const std::vector<steer::Vector2>& getWaypoints() const { return m_wayPoints; }
+
+            /**
+            * \fn steer::Vector2 getWaypoint(Uint32 index) const
+            * \brief Returns a waypoint.
+            * \param index - an Uint32, less than size().
+            **/
+            steer::Vector2 getWaypoint(Uint32 index) const
+            {
+                assert(index < size());
+                return m_wayPoints[index];
+            }
+
+            /**
+            * \fn Uint32 size() const
+            * \brief Returns the number of waypoints.
+            **/
+            Uint32 size() const { return (Uint32)m_wayPoints.size(); }
+
+            /**
+            * \fn bool isLooped() const
+            * \brief Returns true if cursors set to the path loop by default.
+            **/
+            bool isLooped() const { return m_looped; }
+
+        private:
+
+            std::vector<steer::Vector2>             m_wayPoints;///< Waypoints used to define the path the agent will be steered along.
+
+            bool                                    m_looped;///< Flag to indicate if cursors loop by default (The last waypoint connected to the first).
+    };
+
+    /**
+        \class PathCursor
+        \brief An agent's progress along a steer::PathData - the only part of path following that changes.
+    **/
+    class PathCursor
+    {
+        public:
+
+            /**
+            * \fn PathCursor()
+            * \brief Default constructor, a cursor that is not on any path.
+            **/
+            PathCursor() : m_data(nullptr), m_currentWaypoint(0), m_looped(false) {}
+
+            /**
+            * \fn PathCursor(const steer::PathData* data)
+            * \brief Construct a cursor on the first waypoint of a path.
+            * \param data - a pointer to a steer::PathData, which must outlive the cursor.
+            **/
+            explicit PathCursor(const steer::PathData* data) : m_data(nullptr), m_currentWaypoint(0), m_looped(false) { set(data); }
+
+            /**
+            * \fn void set(const steer::PathData* data)
+            * \brief Moves the cursor to the first waypoint of a path and takes on whether the path loops.
+            * \param data - a pointer to a steer::PathData, which must outlive the cursor, or null.
+            **/
+            void set(const steer::PathData* data)
+            {
+                m_data = data;
+                m_currentWaypoint = 0;
+                m_looped = data != nullptr && data->isLooped();
+            }
+
+            /**
+            * \fn const steer::PathData* getData() const
+            * \brief Returns the path the cursor is on, null if none.
+            **/
+            const steer::PathData* getData() const { return m_data; }
+
+            /**
+            * \fn bool valid() const
+            * \brief Returns true if the cursor is on a path with waypoints.
+            **/
+            bool valid() const { return m_data != nullptr && m_data->size() > 0; }
+
+            /**
+            * \fn steer::Vector2 currentWaypoint() const
+            * \brief Returns the current waypoint.
+            **/
+            steer::Vector2 currentWaypoint() const { return m_data->getWaypoint(m_currentWaypoint); }
+
+            /**
+            * \fn Uint32 currentIndex() const
+            * \brief Returns the index of the current waypoint.
+            **/
+            Uint32 currentIndex() const { return m_currentWaypoint; }
+
+            /**
+            * \fn bool finished() const
+            * \brief Returns true if the end of the path has been reached.
+            **/
+            bool finished() const { return m_data == nullptr || m_currentWaypoint >= m_data->size(); }
+
+            /**
+            * \fn void setNextWaypoint()
+            * \brief Moves the cursor on to the next waypoint in the path.
+            **/
+            void setNextWaypoint()
+            {
+                assert(valid());
+
+                if (++m_currentWaypoint == m_data->size() && m_looped)
+                    m_currentWaypoint = 0;
+            }
+
+            /**
+            * \fn void reset()
+            * \brief Moves the cursor back to the first waypoint.
+            **/
+            void reset() { m_currentWaypoint = 0; }
+
+            /**
+            * \fn void loopOn()
+            * \brief Turn on the loop option for the cursor so it meets the first waypoint after the last.
+            **/
+            void loopOn() { m_looped = true; }
+
+            /**
+            * \fn void loopOff()
+            * \brief Turn off the loop option for the cursor so it ends on the last waypoint.
+            **/
+            void loopOff() { m_looped = false; }
+
+            /**
+            * \fn bool isLooped() const
+            * \brief Returns true if the cursor meets the first waypoint after the last.
+            **/
+            bool isLooped() const { return m_looped; }
+
+        private:
+
+            const steer::PathData*                  m_data;///< The path being followed.
+
+            Uint32                                  m_currentWaypoint;///< Index of the current waypoint.
+
+            bool                                    m_looped;///< Flag to indicate if the cursor should loop (The last waypoint connected to the first).
+    };
+
     /**
         \class Path
-        \brief Class providing the necessary structure for path following behavior.
+        \brief Class providing the necessary structure for path following behavior - a steer::PathData along with a cursor on it.
+        <br />Copies of a path share the waypoints, handing every agent its own copy of a long path only copies a pointer and a cursor.
+        To have many agents follow one path without copies, give each agent a steer::PathCursor on a shared steer::PathData instead.
     **/
     class Path
     {
@@ -31,6 +219,14 @@ namespace steer
             **/
             Path(int NumWaypoints, std::list<steer::Vector2>& waypoints);
 
+            /**
+            * \fn Path(const std::vector<steer::Vector2>& waypoints, bool looped = false)
+            * \brief Constructor used for creating a path from a vector of waypoints.
+            * \param waypoints - a std::vector of steer::Vector2.
+            * \param looped - a plain old bool.
+            **/
+            explicit Path(const std::vector<steer::Vector2>& waypoints, bool looped = false);
+
             /**
             * \fn Path(int NumWaypoints, float MinX, float MinY, float MaxX, float MaxY, bool looped);
             * \brief Constructor for creating a path with initial random waypoints. MinX/Y & MaxX/Y define the bounding box of the path.
@@ -50,29 +246,28 @@ namespace steer
             * \fn steer::Vector2 currentWaypoint() const
             * \brief Returns the current waypoint.
             **/
-            steer::Vector2 currentWaypoint() const
-            {
-                assert(&(*m_currentWaypoint) != NULL);
-                return *m_currentWaypoint;
-            }
+            steer::Vector2 currentWaypoint() const { return m_cursor.currentWaypoint(); }
+
+            /**
+            * \fn Uint32 currentIndex() const
+            * \brief Returns the index of the current waypoint.
+            **/
+            Uint32 currentIndex() const { return m_cursor.currentIndex(); }
 
             /**
             * \fn bool finished()
             * \brief Returns true if the end of the list has been reached.
             **/
-            bool finished()
-            {
-                return !(m_currentWaypoint != m_wayPoints.end());
-            }
+            bool finished() const { return m_cursor.finished(); }
 
             /**
             * \fn void setNextWaypoint()
-            * \brief Moves the iterator on to the next waypoint in the list.
+            * \brief Moves the cursor on to the next waypoint in the list.
             **/
-            void setNextWaypoint();
+            void setNextWaypoint() { m_cursor.setNextWaypoint(); }
 
             /**
-            * \fn std::list<steer::Vector2> createRandomPath(int NumWaypoints, float MinX, float MinY, float MaxX, float MaxY)
+            * \fn const std::vector<steer::Vector2>& createRandomPath(int NumWaypoints, float MinX, float MinY, float MaxX, float MaxY)
             * \brief Creates a random path which is bound by rectangle described by the min/max values.
             * \param NumWaypoints - a plain old int.
             * \param MinX - a plain old float.
@@ -80,74 +275,110 @@ namespace steer
             * \param MaxX - a plain old float.
             * \param MaxY - a plain old float.
             **/
-            std::list<steer::Vector2> createRandomPath(int NumWaypoints, float MinX, float MinY, float MaxX, float MaxY);
+            const std::vector<steer::Vector2>& createRandomPath(int NumWaypoints, float MinX, float MinY, float MaxX, float MaxY);
+
+            /**
+            * \fn const std::vector<steer::Vector2>& createRandomPath(steer::RandomStream& random, int NumWaypoints, float MinX, float MinY, float MaxX, float MaxY)
+            * \brief Creates a random path which is bound by rectangle described by the min/max values, drawing from a stream so the same stream position always gives the same path.
+            * \param random - a steer::RandomStream.
+            * \param NumWaypoints - a plain old int.
+            * \param MinX - a plain old float.
+            * \param MinY - a plain old float.
+            * \param MaxX - a plain old float.
+            * \param MaxY - a plain old float.
+            **/
+            const std::vector<steer::Vector2>& createRandomPath(steer::RandomStream& random, int NumWaypoints, float MinX, float MinY, float MaxX, float MaxY);
 
             /**
             * \fn void loopOn()
             * \brief Turn on the loop option for the path so the path meets the first waypoint.
             **/
-            void loopOn()
-            {
-                m_looped = true;
-            }
+            void loopOn() { m_cursor.loopOn(); }
 
             /**
             * \fn void loopOff()
             * \brief Turn off the loop option for the path so the path ends on the last waypoint.
             **/
-            void loopOff()
+            void loopOff() { m_cursor.loopOff(); }
+
+            /**
+            * \fn bool isLooped() const
+            * \brief Returns true if the path meets the first waypoint after the last.
+            **/
+            bool isLooped() const { return m_cursor.isLooped(); }
+
+            /**
+            * \fn void set(const std::list<steer::Vector2>& newPath)
+            * \brief Method for setting the path with list of vectors.
+            * \param newPath - a std::list of steer::Vector2 floats.
+            **/
+            void set(const std::list<steer::Vector2>& newPath)
             {
-                m_looped = false;
+                set(std::vector<steer::Vector2>(newPath.begin(), newPath.end()));
             }
 
             /**
-            * \fn void set(std::list<steer::Vector2> newPath)
-            * \brief Method for setting the path with list of vectors.
+            * \fn void set(const std::vector<steer::Vector2>& newPath)
+            * \brief Method for setting the path with vector of vectors.
             * \param newPath - a std::vector of steer::Vector2 floats.
             **/
-            void set(std::list<steer::Vector2> newPath)
+            void set(const std::vector<steer::Vector2>& newPath)
             {
-                m_wayPoints = newPath;
-
-                m_currentWaypoint = m_wayPoints.begin();
+                setData(std::make_shared<const steer::PathData>(newPath, isLooped()));
             }
 
             /**
             * \fn  set(const Path& path);
-            * \brief Method for setting the path with a previously defined Path.
+            * \brief Method for setting the path with a previously defined Path, sharing its waypoints.
             * \param path - a steer::Path object.
             **/
             void set(const Path& path)
             {
-                m_wayPoints = path.getPath();
-                m_currentWaypoint = m_wayPoints.begin();
+                setData(path.m_data);
             }
 
             /**
             * \fn void clear();
-            * \brief Clears all waypoints in the path std::vector.
+            * \brief Clears all waypoints in the path.
             **/
             void clear()
             {
-                m_wayPoints.clear();
+                setData(emptyData());
             }
 
             /**
-            * \fn std::list<steer::Vector2> getPath() const;
-            * \brief Returns the std::vector of waypoints in the path.
+            * \fn const std::vector<steer::Vector2>& getPath() const;
+            * \brief Returns the waypoints in the path.
+            **/
+            const std::vector<steer::Vector2>& getPath() const { return m_data->getWaypoints(); }
+
+            /**
+            * \fn const steer::PathData* getData() const;
+            * \brief Returns the waypoints of the path, to set other cursors to.
+            **/
+            const steer::PathData* getData() const { return m_data.get(); }
+
+            /**
+            * \fn steer::PathCursor& getCursor();
+            * \brief Returns the cursor of the path.
+            **/
+            steer::PathCursor& getCursor() { return m_cursor; }
+
+            /**
+            * \fn Uint32 size() const;
+            * \brief Returns the number of waypoints in the path.
             **/
-            std::list<steer::Vector2> getPath() const {return m_wayPoints;}
+            Uint32 size() const { return m_data->size(); }
 
         private:
 
-            std::list<steer::Vector2>               m_wayPoints;///< Waypoints used to define the path the agent will be steered along.
+            static const std::shared_ptr<const steer::PathData>& emptyData();
 
-            //points to the current waypoint
-            std::list<steer::Vector2>::iterator     m_currentWaypoint;///< An iterator (pointer) that points to the current waypoint.
+            void setData(const std::shared_ptr<const steer::PathData>& data);
 
-            unsigned int                            m_numWaypoints;///< The number of waypoints that define the path.
+            std::shared_ptr<const steer::PathData>  m_data;///< Waypoints used to define the path the agent will be steered along, shared by copies of the path.
 
-            bool                                    m_looped;///< Flag to indicate if the path should be looped (The last waypoint connected to the first).
+            steer::PathCursor                       m_cursor;///< Position of the path on its waypoints.
     };
 }
 
@@ -0,0 +1,212 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <chrono>
+#include <iosfwd>
+
+#include <steeriously/Utilities.hpp>
+
+namespace steer
+{
+    namespace profile
+    {
+        /**
+        *\enum Phase
+        *\brief The timed parts of the steering pipeline. Behaviors calling other behaviors (Pursuit seeks, PathFollowing arrives...) count towards both.
+        **/
+        enum Phase
+        {
+            seek,
+            flee,
+            arrive,
+            pursuit,
+            evade,
+            offsetPursuit,
+            interpose,
+            hide,
+            wander,
+            followPath,
+            separation,
+            alignment,
+            cohesion,
+            flocking,
+            obstacleAvoidance,
+            wallAvoidance,
+            tagNeighbors,///< gathering or tagging the neighbors of an agent.
+            tagObstacles,///< tagging the obstacles in front of an agent.
+            calculate,///< a whole Calculate of a SuperComponent.
+            integrate,///< moving agents according to their steering force.
+            worldIndices,///< stage one of World::step, refreshing the spatial indices and the list of awake agents.
+            worldForces,///< stage two of World::step, computing every steering force.
+            worldIntegrate,///< stage three of World::step, integrating every agent.
+            worldSettle,///< stage four of World::step, putting agents to sleep and waking them up.
+            phaseCount
+        };
+
+        /**
+        *\enum Counter
+        *\brief The amounts of work counted in the steering pipeline.
+        **/
+        enum Counter
+        {
+            neighborsVisited,///< neighbors looked at by the flocking behaviors.
+            obstaclesTested,///< obstacles range tested by obstacle avoidance and hide.
+            wallsTested,///< wall segments intersected with feelers.
+            counterCount
+        };
+    }
+
+    /**
+    *\struct ProfileFrame
+    *\brief Calls, time and work of the pipeline, over one tick or summed over many.
+    **/
+    struct ProfileFrame
+    {
+        Uint64  calls[profile::phaseCount];///< Number of times each phase ran.
+        Uint64  nanoseconds[profile::phaseCount];///< Time spent in each phase, summed over every thread.
+        Uint64  counters[profile::counterCount];///< Work done, by counter.
+        Uint64  ticks;///< Number of ticks summed into the frame.
+
+        /// Zeroes the frame.
+        void clear();
+
+        /// Returns the time spent in a phase in milliseconds.
+        double milliseconds(profile::Phase phase) const { return nanoseconds[phase] * 1e-6; }
+    };
+
+    /**
+        \class Profiler
+        \brief Per-phase timings and work counters of the steering pipeline.
+        <br />Recording is compiled in only when the library and your project are built with STEERIOUSLY_PROFILE
+        defined, otherwise the STEERIOUSLY_PROFILE_* macros expand to nothing and the pipeline runs untouched.
+        <br />Every thread records into counters of its own, so agents updated on several threads do not contend.
+        Call endTick once per frame (steer::World::step does) to close a tick - the counters of the last tick and
+        the running totals can then be queried, and a summary is written every few ticks if asked for.
+    **/
+    class Profiler
+    {
+    public:
+
+        /**
+        * \fn static void record(profile::Phase phase, Uint64 nanoseconds)
+        * \brief Records one run of a phase.
+        * \param phase - a steer::profile::Phase.
+        * \param nanoseconds - an Uint64.
+        **/
+        static void record(profile::Phase phase, Uint64 nanoseconds);
+
+        /**
+        * \fn static void count(profile::Counter counter, Uint64 amount)
+        * \brief Adds work to a counter.
+        * \param counter - a steer::profile::Counter.
+        * \param amount - an Uint64.
+        **/
+        static void count(profile::Counter counter, Uint64 amount);
+
+        /**
+        * \fn static void endTick()
+        * \brief Closes the current tick, call it when no thread is recording. Writes a summary when one is due.
+        **/
+        static void endTick();
+
+        /**
+        * \fn static const steer::ProfileFrame& lastTick()
+        * \brief Returns what was recorded during the last closed tick.
+        **/
+        static const steer::ProfileFrame& lastTick();
+
+        /**
+        * \fn static const steer::ProfileFrame& totals()
+        * \brief Returns everything recorded up to the last closed tick since the last reset.
+        **/
+        static const steer::ProfileFrame& totals();
+
+        /**
+        * \fn static void reset()
+        * \brief Zeroes every counter, call it when no thread is recording.
+        **/
+        static void reset();
+
+        /**
+        * \fn static void setSummaryInterval(Uint32 ticks, std::ostream* out)
+        * \brief Writes a summary of the last ticks every so many ticks.
+        * \param ticks - an Uint32, zero turns the summary off.
+        * \param out - a pointer to a std::ostream, which must outlive the summaries.
+        **/
+        static void setSummaryInterval(Uint32 ticks, std::ostream* out);
+
+        /**
+        * \fn static void writeSummary(std::ostream& out, const steer::ProfileFrame& frame)
+        * \brief Writes a table of the phases and counters of a frame, averaged per tick.
+        * \param out - a std::ostream.
+        * \param frame - a steer::ProfileFrame.
+        **/
+        static void writeSummary(std::ostream& out, const steer::ProfileFrame& frame);
+
+        /**
+        * \fn static const char* name(profile::Phase phase)
+        * \brief Returns the name of a phase.
+        * \param phase - a steer::profile::Phase.
+        **/
+        static const char* name(profile::Phase phase);
+
+        /**
+        * \fn static const char* name(profile::Counter counter)
+        * \brief Returns the name of a counter.
+        * \param counter - a steer::profile::Counter.
+        **/
+        static const char* name(profile::Counter counter);
+    };
+
+    /**
+        \class ProfileScope
+        \brief Records the time from its construction to its destruction against a phase.
+    **/
+    class ProfileScope
+    {
+    public:
+
+        /**
+        * \fn explicit ProfileScope(profile::Phase phase)
+        * \brief Starts timing a phase.
+        * \param phase - a steer::profile::Phase.
+        **/
+        explicit ProfileScope(profile::Phase phase)
+        : m_phase(phase)
+        , m_start(std::chrono::steady_clock::now())
+        {
+        }
+
+        /// Destructor - records the phase.
+        ~ProfileScope()
+        {
+            Profiler::record(m_phase, (Uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count());
+        }
+
+    private:
+
+        ProfileScope(const ProfileScope&);
+        ProfileScope& operator=(const ProfileScope&);
+
+        profile::Phase                          m_phase;///< The phase being timed.
+        std::chrono::steady_clock::time_point   m_start;///< When timing started.
+    };
+}
+
+#define STEERIOUSLY_PROFILE_CONCAT_IMPL(a, b) a##b
+#define STEERIOUSLY_PROFILE_CONCAT(a, b) STEERIOUSLY_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef STEERIOUSLY_PROFILE
+    /// Times the rest of the enclosing scope against a steer::profile::Phase.
+    #define STEERIOUSLY_PROFILE_SCOPE(phase) steer::ProfileScope STEERIOUSLY_PROFILE_CONCAT(steeriouslyProfileScope, __LINE__)(phase)
+    /// Adds an amount of work to a steer::profile::Counter.
+    #define STEERIOUSLY_PROFILE_COUNT(counter, amount) steer::Profiler::count(counter, (Uint64)(amount))
+    /// Closes a tick of the profiler.
+    #define STEERIOUSLY_PROFILE_TICK() steer::Profiler::endTick()
+#else
+    #define STEERIOUSLY_PROFILE_SCOPE(phase) ((void)0)
+    #define STEERIOUSLY_PROFILE_COUNT(counter, amount) ((void)0)
+    #define STEERIOUSLY_PROFILE_TICK() ((void)0)
+#endif
+
+#endif // PROFILER_HPP
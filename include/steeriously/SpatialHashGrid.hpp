@@ -0,0 +1,138 @@
+#ifndef SPATIALHASHGRID_HPP
+#define SPATIALHASHGRID_HPP
+
+#include <vector>
+
+#include <steeriously/BehaviorData.hpp>
+#include <steeriously/Utilities.hpp>
+#include <steeriously/Vector2.hpp>
+
+namespace steer
+{
+    class Agent;
+
+    /**
+        \class SpatialHashGrid
+        \brief A uniform grid of square cells hashed into a fixed number of buckets.
+        <br />Agents register with the grid so that neighborhood queries only visit the cells
+        surrounding an agent instead of scanning every agent in the world. With the cell size
+        picked from the query radius a query never visits more than the 3x3 cells around the agent.
+        <br />Double-buffered agents are binned and found at their published position.
+    **/
+    class SpatialHashGrid
+    {
+    public:
+
+        /**
+        * \fn SpatialHashGrid(float cellSize, Uint32 numBuckets = 4096)
+        * \brief Construct a grid from a cell size.
+        * \param cellSize - a plain old float, should be at least the largest query radius plus the largest agent bounding radius.
+        * \param numBuckets - an Uint32, rounded up to the next power of two.
+        **/
+        SpatialHashGrid(float cellSize, Uint32 numBuckets = 4096);
+
+        /**
+        * \fn SpatialHashGrid(const steer::BehaviorParameters& params, Uint32 numBuckets = 4096)
+        * \brief Construct a grid with a cell size picked from the view distance, neighborhood radius and bounding radius in the parameters.
+        * \param params - a steer::BehaviorParameters object.
+        * \param numBuckets - an Uint32, rounded up to the next power of two.
+        **/
+        SpatialHashGrid(const steer::BehaviorParameters& params, Uint32 numBuckets = 4096);
+
+        /// Destructor
+        ~SpatialHashGrid();
+
+        /**
+        * \fn void registerEntity(steer::Agent* agent)
+        * \brief Adds an agent to the cell containing its current position. Prefer steer::Agent::setCellSpace, which keeps the agent informed of the grid it belongs to.
+        * \param agent - a steer::Agent derived object.
+        **/
+        void registerEntity(steer::Agent* agent);
+
+        /**
+        * \fn void unregisterEntity(steer::Agent* agent)
+        * \brief Removes an agent from the grid.
+        * \param agent - a steer::Agent derived object.
+        **/
+        void unregisterEntity(steer::Agent* agent);
+
+        /**
+        * \fn void updateEntity(steer::Agent* agent, steer::Vector2 oldPosition)
+        * \brief Moves an agent to a different bucket, but only when its move from the old position crossed into another cell.
+        * \param agent - a steer::Agent derived object.
+        * \param oldPosition - a steer::Vector2, the position the agent was last binned at.
+        **/
+        void updateEntity(steer::Agent* agent, steer::Vector2 oldPosition);
+
+        /**
+        * \fn void updateRadius(float radius)
+        * \brief Widens queries to the new bounding radius of a registered agent, steer::Agent::setBoundingRadius calls it. Shrinking radii are picked up by rebuild.
+        * \param radius - a plain old float.
+        **/
+        void updateRadius(float radius) { m_maxEntityRadius = MaxOf(m_maxEntityRadius, radius); }
+
+        /**
+        * \fn void rebuild()
+        * \brief Re-bins every registered agent according to its current position.
+        **/
+        void rebuild();
+
+        /**
+        * \fn void clear()
+        * \brief Removes every agent from the grid.
+        **/
+        void clear();
+
+        /**
+        * \fn void query(steer::Vector2 position, float radius, std::vector<steer::Agent*>& result, const steer::Agent* exclude = nullptr) const
+        * \brief Appends every registered agent within radius (plus its own bounding radius) of the position to result.
+        * \param position - a steer::Vector2 of floats.
+        * \param radius - a plain old float.
+        * \param result - a std::vector of steer::Agent pointers.
+        * \param exclude - an agent to leave out of the result, usually the agent doing the query.
+        **/
+        void query(steer::Vector2 position, float radius, std::vector<steer::Agent*>& result, const steer::Agent* exclude = nullptr) const;
+
+        /**
+        * \fn float getCellSize() const
+        * \brief Returns the length of a side of a cell.
+        **/
+        float getCellSize() const { return m_cellSize; }
+
+        /**
+        * \fn Uint32 size() const
+        * \brief Returns the number of registered agents.
+        **/
+        Uint32 size() const { return m_numEntities; }
+
+    private:
+
+        /**
+        * \struct Entry
+        * \brief An agent and the cell it was binned into - several cells may share a bucket.
+        **/
+        struct Entry
+        {
+            steer::Agent*   agent;
+            Int32           cellX;
+            Int32           cellY;
+        };
+
+        Int32 cellCoord(double value) const;
+
+        Uint32 bucketIndex(Int32 cellX, Int32 cellY) const;
+
+        void insert(steer::Agent* agent, Int32 cellX, Int32 cellY);
+
+        bool remove(steer::Agent* agent, Int32 cellX, Int32 cellY);
+
+        std::vector< std::vector<Entry> >           m_buckets;///< Buckets of agents, indexed by the hashed cell coordinates.
+        float                                       m_cellSize;///< Length of a side of a cell.
+        float                                       m_inverseCellSize;///< Cached reciprocal of the cell size.
+        Uint32                                      m_bucketMask;///< Number of buckets minus one (the bucket count is a power of two).
+        Uint32                                      m_numEntities;///< Number of registered agents.
+        float                                       m_maxEntityRadius;///< Largest bounding radius of a registered agent, widens queries so no neighbor is missed.
+    };
+}
+
+#endif // SPATIALHASHGRID_HPP
@@ -39,13 +39,17 @@
 
 #include <steeriously/Agent.hpp>
 #include <steeriously/BehaviorHelpers.hpp>
+#include <steeriously/FlockingKernel.hpp>
 #include <steeriously/GeometryHelpers.hpp>
+#include <steeriously/ObstacleIndex.hpp>
 #include <steeriously/Path.hpp>
+#include <steeriously/Profiler.hpp>
 #include <steeriously/Transformations.hpp>
 #include <steeriously/Utilities.hpp>
 #include <steeriously/Vector2.hpp>
 #include <steeriously/VectorMath.hpp>
 #include <steeriously/Wall.hpp>
+#include <steeriously/WallIndex.hpp>
 
 /**
 *\brief All steering functions are templated for easy application
@@ -81,7 +85,7 @@ namespace steer //begin steeriously namespace
 	template<class T, class N>
 	steer::Vector2 calculateTarget(const T& agent, const N& other)
 	{
-		steer::Vector2 to = other->getPosition() - agent->getPosition();
+		steer::Vector2 to = other->getPublishedPosition() - agent->getPosition();
 
 		//constrains processing to those cases where
 		//the other agent is within range
@@ -91,10 +95,10 @@ namespace steer //begin steeriously namespace
 		//find the time in the future to extrapolate to
 		//as a function of the distance between the agents
 		//and their speeds
-		float extrapolateTime = VectorMath::length(to) / (agent->getMaxSpeed() + other->getSpeed());
+		float extrapolateTime = VectorMath::length(to) / (agent->getMaxSpeed() + other->getPublishedSpeed());
 
 		//target acquired!
-		steer::Vector2 target = steer::Vector2(other->getPosition() + other->getVelocity() * extrapolateTime);
+		steer::Vector2 target = steer::Vector2(other->getPublishedPosition() + other->getPublishedVelocity() * extrapolateTime);
 		return target;
 	}
 
@@ -110,7 +114,7 @@ namespace steer //begin steeriously namespace
 	steer::Vector2 calculateTarget(const T& agent, const N& otherA, const P& otherB)
 	{
 		//find the midpoint between the two other agents
-		steer::Vector2 mid = (otherA->getPosition() + otherB->getPosition()) / 2.f;
+		steer::Vector2 mid = (otherA->getPublishedPosition() + otherB->getPublishedPosition()) / 2.f;
 
 		//find the time in the future to extrapolate to
 		//as a function of the distance between the agent
@@ -119,8 +123,8 @@ namespace steer //begin steeriously namespace
 
 		//extrapolate position based on time in the future
 		//assuming the other agents are moving in a straight line
-		steer::Vector2 posA = otherA->getPosition() + otherA->getVelocity() * extrapolateTime;
-		steer::Vector2 posB = otherB->getPosition() + otherB->getVelocity() * extrapolateTime;
+		steer::Vector2 posA = otherA->getPublishedPosition() + otherA->getPublishedVelocity() * extrapolateTime;
+		steer::Vector2 posB = otherB->getPublishedPosition() + otherB->getPublishedVelocity() * extrapolateTime;
 
 		//midpoint found - voila!
 		mid = (posA + posB) / 2.f;
@@ -137,6 +141,8 @@ namespace steer //begin steeriously namespace
 	template <class T>
 	steer::Vector2 Seek(const T& agent)
 	{
+		STEERIOUSLY_PROFILE_SCOPE(steer::profile::seek);
+
 		steer::Vector2 velocity = { 0.0, 0.0 };
 		if (agent != nullptr)
 		{
@@ -156,6 +162,8 @@ namespace steer //begin steeriously namespace
 	template <class T>
 	steer::Vector2 Seek(const T& agent, steer::Vector2 target)
 	{
+		STEERIOUSLY_PROFILE_SCOPE(steer::profile::seek);
+
 		steer::Vector2 velocity = { 0.0, 0.0 };
 
 		velocity = VectorMath::normalize(target - agent->getPosition()) * agent->getMaxSpeed();
@@ -164,15 +172,19 @@ namespace steer //begin steeriously namespace
 	};
 
 	/**
-	* \fn   template<class T, class conT>
-	*       steer::Vector2 Alignment(const T& agent, const conT& neighbors);
+	* \fn   template <class T, class conT, class Pred>
+	*       steer::Vector2 Alignment(const T& agent, const conT& neighbors, Pred accept = Pred());
 	* \brief Template function for keeping groups of agents in alignment.
 	* \param agent - a steer::Agent derived object.
 	* \param neighbors - a std::vector container of steer::Agent derived objects.
+	* \param accept - a predicate picking the neighbors to consider, steer::TaggedInGroup by default. Pass steer::AnyNeighbor for a list already gathered by range.
 	**/
-	template<class T, class conT>
-	steer::Vector2 Alignment(const T& agent, const conT& neighbors)
+	template <class T, class conT, class Pred = steer::TaggedInGroup>
+	steer::Vector2 Alignment(const T& agent, const conT& neighbors, Pred accept = Pred())
 	{
+		STEERIOUSLY_PROFILE_SCOPE(steer::profile::alignment);
+		STEERIOUSLY_PROFILE_COUNT(steer::profile::neighborsVisited, neighbors.size());
+
 		steer::Vector2 avg = steer::Vector2(0.0, 0.0);
 		int count = 0;
 
@@ -181,12 +193,12 @@ namespace steer //begin steeriously namespace
 		    for (auto& i : neighbors)
 			{
 				//exclude agent of interest, make sure
-				//neighboring agents are tagged in the group
-				if (i != nullptr && i != agent && i->taggedInGroup())
+				//neighboring agents are accepted in the group
+				if (i != nullptr && i != agent && accept(i))
 				{
 					//summing the heading vectors of
 					//agents tagged in the group
-					avg += i->getHeading();
+					avg += i->getPublishedHeading();
 
 					++count;
 				}
@@ -205,15 +217,19 @@ namespace steer //begin steeriously namespace
 	}
 
 	/**
-	* \fn   template <class T, class conT>
-	*		steer::Vector2 Separation(const T& agent, const conT& neighbors);
+	* \fn   template <class T, class conT, class Pred>
+	*		steer::Vector2 Separation(const T& agent, const conT& neighbors, Pred accept = Pred());
 	* \brief Template function for keeping groups of agents from clumping together.
 	* \param agent - a steer::Agent derived object.
 	* \param neighbors - a std::vector container of steer::Agent derived objects.
+	* \param accept - a predicate picking the neighbors to consider, steer::TaggedInGroup by default. Pass steer::AnyNeighbor for a list already gathered by range.
 	**/
-	template <class T, class conT>
-	steer::Vector2 Separation(const T& agent, const conT& neighbors)
+	template <class T, class conT, class Pred = steer::TaggedInGroup>
+	steer::Vector2 Separation(const T& agent, const conT& neighbors, Pred accept = Pred())
 	{
+		STEERIOUSLY_PROFILE_SCOPE(steer::profile::separation);
+		STEERIOUSLY_PROFILE_COUNT(steer::profile::neighborsVisited, neighbors.size());
+
 		steer::Vector2 force = steer::Vector2(0.0, 0.0);
 		steer::Vector2 toTarget = steer::Vector2(0.0, 0.0);
 		steer::Vector2 normal = steer::Vector2(0.0, 0.0);
@@ -224,10 +240,10 @@ namespace steer //begin steeriously namespace
 		    for (auto& i : neighbors)
 			{
 				//exclude agent of interest and make
-				//sure neighboring agents are tagged in the group
-				if (i != nullptr && i != agent && i->taggedInGroup())
+				//sure neighboring agents are accepted in the group
+				if (i != nullptr && i != agent && accept(i))
 				{
-					toTarget = agent->getPosition() - i->getPosition();
+					toTarget = agent->getPosition() - i->getPublishedPosition();
 
 					normal = VectorMath::normalize(toTarget);
 					length = VectorMath::length(toTarget);
@@ -243,15 +259,19 @@ namespace steer //begin steeriously namespace
 	}
 
 	/**
-	* \fn	template <class T, class conT>
-	*		steer::Vector2 Cohesion(const T& agent, const conT& neighbors);
+	* \fn	template <class T, class conT, class Pred>
+	*		steer::Vector2 Cohesion(const T& agent, const conT& neighbors, Pred accept = Pred());
 	* \brief Template function for keeping groups of agents cohesive.
 	* \param agent - a steer::Agent derived object.
 	* \param neighbors - a std::vector container of steer::Agent derived objects.
+	* \param accept - a predicate picking the neighbors to consider, steer::TaggedInGroup by default. Pass steer::AnyNeighbor for a list already gathered by range.
 	**/
-	template <class T, class conT>
-	steer::Vector2 Cohesion(const T& agent, const conT& neighbors)
+	template <class T, class conT, class Pred = steer::TaggedInGroup>
+	steer::Vector2 Cohesion(const T& agent, const conT& neighbors, Pred accept = Pred())
 	{
+		STEERIOUSLY_PROFILE_SCOPE(steer::profile::cohesion);
+		STEERIOUSLY_PROFILE_COUNT(steer::profile::neighborsVisited, neighbors.size());
+
 		steer::Vector2 centerOfMass = steer::Vector2(0.0, 0.0);
 		steer::Vector2 force = steer::Vector2(0.0, 0.0);
 
@@ -262,11 +282,11 @@ namespace steer //begin steeriously namespace
 		    for (auto& i : neighbors)
 			{
 				//exclude agent of interest and make sure
-				//nighboring agents are tagged in the group
-				if (i != nullptr && i != agent && i->taggedInGroup())
+				//nighboring agents are accepted in the group
+				if (i != nullptr && i != agent && accept(i))
 				{
 					//sum their positions
-					centerOfMass += i->getPosition();
+					centerOfMass += i->getPublishedPosition();
 
 					++count;
 				}
@@ -293,6 +313,65 @@ namespace steer //begin steeriously namespace
 		return force;
 	};
 
+	/**
+	* \fn	template <class T, class conT, class Pred>
+	*		steer::FlockingForces Flocking(const T& agent, const conT& neighbors, steer::NeighborPack& pack, Pred accept = Pred());
+	* \brief Template function computing Separation, Alignment and Cohesion together.
+	* <br />The accepted neighbors are packed into flat float arrays once and summed in a single SIMD pass, separation divides by the squared distance instead of normalizing.
+	* Neighbors sitting exactly on top of the agent add no separation.
+	* \param agent - a steer::Agent derived object.
+	* \param neighbors - a std::vector container of steer::Agent derived objects.
+	* \param pack - a steer::NeighborPack used as scratch memory.
+	* \param accept - a predicate picking the neighbors to consider, steer::TaggedInGroup by default. Pass steer::AnyNeighbor for a list already gathered by range.
+	**/
+	template <class T, class conT, class Pred = steer::TaggedInGroup>
+	steer::FlockingForces Flocking(const T& agent, const conT& neighbors, steer::NeighborPack& pack, Pred accept = Pred())
+	{
+		STEERIOUSLY_PROFILE_SCOPE(steer::profile::flocking);
+		STEERIOUSLY_PROFILE_COUNT(steer::profile::neighborsVisited, neighbors.size());
+
+		steer::FlockingForces forces;
+
+		if (agent == nullptr)
+			return forces;
+
+		pack.clear();
+
+		steer::Vector2 position = agent->getPosition();
+
+		for (auto& i : neighbors)
+		{
+			//exclude agent of interest and make sure
+			//neighboring agents are accepted in the group
+			if (i != nullptr && i != agent && accept(i))
+			{
+				pack.add(i->getPublishedPosition() - position, i->getPublishedHeading());
+			}
+		}
+
+		Uint32 count = pack.size();
+
+		if (count > 0)
+		{
+			steer::FlockingSums sums = SumNeighborPack(pack);
+
+			forces.separation = sums.separation;
+
+			//average heading relative to our own
+			forces.alignment = sums.heading / (float)count - agent->getHeading();
+
+			//seek the center of mass
+			forces.cohesion = Seek(agent, position + sums.offset / (float)count);
+		}
+
+		//normalize due to the fact that
+		//cohesion generally factors in
+		//higher than separation and alignment
+		forces.cohesion = VectorMath::normalize(forces.cohesion);
+
+		return forces;
+	}
+
 	/**
 	* \fn	template<class T, Uint32>
 	*		steer::Vector2 Arrive(const T& agent, Uint32 deceleration);
@@ -303,6 +382,8 @@ namespace steer //begin steeriously namespace
 	template<class T>
 	steer::Vector2 Arrive(const T& agent, Uint32 deceleration)
 	{
+		STEERIOUSLY_PROFILE_SCOPE(steer::profile::arrive);
+
 		steer::Vector2 target = agent->getTarget() - agent->getPosition();
 
 		//calculate the distance to the target
@@ -337,23 +418,25 @@ namespace steer //begin steeriously namespace
 	template<class T, class N>
 	steer::Vector2 Pursuit(const T& agent, const N& evader)
 	{
-		steer::Vector2 to = evader->getPosition() - agent->getPosition();
+		STEERIOUSLY_PROFILE_SCOPE(steer::profile::pursuit);
+
+		steer::Vector2 to = evader->getPublishedPosition() - agent->getPosition();
 
-		float heading = VectorMath::dotProduct(agent->getHeading(), evader->getHeading());
+		float heading = VectorMath::dotProduct(agent->getHeading(), evader->getPublishedHeading());
 
 		//evading agent is ahead, so seek to it
 		if ((VectorMath::dotProduct(to, agent->getHeading()) > 0) && (heading < -0.95))//acos(0.95)=18 degs
 		{
-			agent->setTarget(evader->getPosition());
+			agent->setTarget(evader->getPublishedPosition());
 			return Seek<T>(agent);
 		}
 
 		//evading agent is not ahead
 		//...extrapolate its future position
-		float extrapolationTime = VectorMath::length(to) / (agent->getMaxSpeed() + evader->getSpeed());
+		float extrapolationTime = VectorMath::length(to) / (agent->getMaxSpeed() + evader->getPublishedSpeed());
 
 		//seek...
-		agent->setTarget(evader->getPosition() + evader->getVelocity() * extrapolationTime);
+		agent->setTarget(evader->getPublishedPosition() + evader->getPublishedVelocity() * extrapolationTime);
 		return Seek<T>(agent);
 	}
 
@@ -368,8 +451,10 @@ namespace steer //begin steeriously namespace
 	template<class T, class N>
 	steer::Vector2 OffsetPursuit(const T& agent, const N& leader, const steer::BehaviorParameters& parameters)
 	{
+		STEERIOUSLY_PROFILE_SCOPE(steer::profile::offsetPursuit);
+
 		//thisAgent->setTarget(calculateTarget(thisAgent, leader));
-		agent->setTarget(leader->getPosition());
+		agent->setTarget(leader->getPublishedPosition());
 
 		steer::Vector2 to = agent->getTarget() - agent->getPosition();
 
@@ -402,6 +487,8 @@ namespace steer //begin steeriously namespace
 	template<class T>
 	steer::Vector2 Flee(const T& agent)
 	{
+		STEERIOUSLY_PROFILE_SCOPE(steer::profile::flee);
+
 		steer::Vector2 velocity = VectorMath::normalize(agent->getPosition() - agent->getTarget()) * agent->getMaxSpeed();
 		if (VectorMath::distanceSquared(agent->getPosition(), agent->getTarget()) > agent->getThreatRange()*agent->getThreatRange())
 			return steer::Vector2(0.0, 0.0);
@@ -419,6 +506,8 @@ namespace steer //begin steeriously namespace
 	template<class T, class N>
 	steer::Vector2 Evade(const T& agent, const N& other)
 	{
+		STEERIOUSLY_PROFILE_SCOPE(steer::profile::evade);
+
 		agent->setTarget(calculateTarget<T,N>(agent, other));
 
 		steer::Vector2 velocity = VectorMath::normalize(agent->getPosition() - agent->getTarget()) * agent->getMaxSpeed();
@@ -463,13 +552,16 @@ namespace steer //begin steeriously namespace
 	template<class T, class N, class conT>
 	steer::Vector2 Hide(const T& agent, const N& other, const conT& obstacles, const steer::BehaviorParameters& parameters)
 	{
+		STEERIOUSLY_PROFILE_SCOPE(steer::profile::hide);
+		STEERIOUSLY_PROFILE_COUNT(steer::profile::obstaclesTested, obstacles.size());
+
 		float closest = steer::MaxFloat;
 		steer::Vector2 best;
 
 		for (auto& ob : obstacles)
 		{
 			//find a hiding spot, given each obstacle
-			steer::Vector2 spot = findPosition(ob->getPosition(), ob->getRadius(), other->getPosition(), agent->getDistanceBuffer());
+			steer::Vector2 spot = findPosition(ob->getPosition(), ob->getRadius(), other->getPublishedPosition(), agent->getDistanceBuffer());
 
 			//determine the closest hiding spot
 			float distance = steer::VectorMath::distanceSquared(spot, agent->getPosition());
@@ -495,6 +587,31 @@ namespace steer //begin steeriously namespace
 		return Arrive<T>(agent, parameters.deceleration);
 	}
 
+	/**
+	* \fn	template<class T, class N>
+	*		steer::Vector2 Hide(const T& agent, const N& other, const steer::ObstacleIndex& obstacles, const steer::BehaviorParameters& parameters);
+	* \brief Same as Hide over a container, but only looks for hiding spots behind the parameters.HideCandidates obstacles nearest the agent.
+	* \param agent - a steer::Agent derived object.
+	* \param other - a steer::Agent derived object.
+	* \param obstacles - a steer::ObstacleIndex.
+	* \param parameters - a steer::BehaviorParameters object.
+	**/
+	template<class T, class N>
+	steer::Vector2 Hide(const T& agent, const N& other, const steer::ObstacleIndex& obstacles, const steer::BehaviorParameters& parameters)
+	{
+		//one list per thread, so agents can be updated in parallel
+		//without allocating every frame
+		static thread_local std::vector<steer::SphereObstacle*> candidates;
+		candidates.clear();
+
+		{
+			STEERIOUSLY_PROFILE_SCOPE(steer::profile::tagObstacles);
+			obstacles.nearest(agent->getPosition(), parameters.HideCandidates, candidates);
+		}
+
+		return Hide(agent, other, candidates, parameters);
+	}
+
 	/**
 	* \fn	template<class T, class N, class P, Uint32>
 	*		steer::Vector2 Interpose(const T& agent, const N& otherA, const P& otherB, const steer::BehaviorParameters& parameters);
@@ -507,6 +624,8 @@ namespace steer //begin steeriously namespace
 	template<class T, class N, class P>
 	steer::Vector2 Interpose(const T& agent, const N& otherA, const P& otherB, const steer::BehaviorParameters& parameters)
 	{
+		STEERIOUSLY_PROFILE_SCOPE(steer::profile::interpose);
+
 		//calculate target given two agents
 		agent->setTarget(calculateTarget<T,N,P>(agent, otherA, otherB));
 
@@ -538,14 +657,19 @@ namespace steer //begin steeriously namespace
 	template<class T>
 	steer::Vector2 Wander(const T& agent)
 	{
+		STEERIOUSLY_PROFILE_SCOPE(steer::profile::wander);
+
 		if (agent != nullptr)
 		{
 			//this behavior is dependent on the update rate, so this line must
             //be included when using time independent framerate.
             float JitterThisTimeSlice = agent->m_wanderJitter * agent->getElapsedTime();
 
-            //first, add a small random vector to the target's position
-            agent->m_wanderTarget += steer::Vector2(RandomClamped() * JitterThisTimeSlice, RandomClamped() * JitterThisTimeSlice);
+            //first, add a small random vector to the target's position, drawn
+            //one after the other so every compiler gets the same x and y
+            float jitterX = agent->getRandom().nextClamped() * JitterThisTimeSlice;
+            float jitterY = agent->getRandom().nextClamped() * JitterThisTimeSlice;
+            agent->m_wanderTarget += steer::Vector2(jitterX, jitterY);
 
             //reproject this new vector back on to a unit circle
             agent->m_wanderTarget = VectorMath::normalize(agent->m_wanderTarget);
@@ -575,12 +699,16 @@ namespace steer //begin steeriously namespace
 	template <class T, class conT>
 	steer::Vector2 ObstacleAvoidance(const T& agent, const conT& obstacles, const steer::BehaviorParameters& parameters)
 	{
+		STEERIOUSLY_PROFILE_SCOPE(steer::profile::obstacleAvoidance);
+		STEERIOUSLY_PROFILE_COUNT(steer::profile::obstaclesTested, obstacles.size());
+
 	    //the detection box length is proportional to the agent's velocity
 		agent->setBoxLength(parameters.MinDetectionBoxLength + (agent->getSpeed() / agent->getMaxSpeed()) * parameters.MinDetectionBoxLength);
 
-        //tag obstacles...
-        steer::TagObstaclesWithinViewRange< T, conT >(agent, obstacles, agent->m_boxLength);
-
+		//range test each obstacle here instead of tagging them, the
+		//obstacles are shared by every agent and tags would have every
+		//agent writing to them
+		float boxLength = agent->boxLength();
 		//closest obstacle
 		steer::SphereObstacle* closest = nullptr;
 
@@ -592,7 +720,14 @@ namespace steer //begin steeriously namespace
 
 		for (auto& i : obstacles)
 		{
-			if (i != nullptr && i->taggedInGroup())
+			if (i == nullptr)
+				continue;
+
+			//the radius of the obstacle is taken into account by adding it
+			//to the range, working in distance-squared space to avoid sqrts
+			float range = boxLength + i->getRadius();
+
+			if (steer::VectorMath::lengthSquared(i->getPosition() - agent->getPosition()) < range*range)
 			{
 				//get obstacle position
 				steer::Vector2 local = PointToLocalSpace(i->getPosition(), agent->getHeading(), agent->getSide(), agent->getPosition());
@@ -653,6 +788,35 @@ namespace steer //begin steeriously namespace
 		return VectorToWorldSpace(force, agent->getHeading(), agent->getSide());
 	}
 
+	/**
+	* \fn   template <class T>
+	*		steer::Vector2 ObstacleAvoidance(const T& agent, const steer::ObstacleIndex& obstacles, const steer::BehaviorParameters& parameters);
+	* \brief Same as ObstacleAvoidance over a container, but only tests the obstacles the index finds around the detection box.
+	* \param agent - a steer::Agent derived object.
+	* \param obstacles - a steer::ObstacleIndex.
+	* \param parameters - a steer::BehaviorParameters object.
+	**/
+	template <class T>
+	steer::Vector2 ObstacleAvoidance(const T& agent, const steer::ObstacleIndex& obstacles, const steer::BehaviorParameters& parameters)
+	{
+		//an obstacle in range of the detection box overlaps the square
+		//around the agent that the box can sweep
+		float boxLength = parameters.MinDetectionBoxLength + (agent->getSpeed() / agent->getMaxSpeed()) * parameters.MinDetectionBoxLength;
+		steer::Vector2 extent(boxLength, boxLength);
+
+		//one list per thread, so agents can be updated in parallel
+		//without allocating every frame
+		static thread_local std::vector<steer::SphereObstacle*> candidates;
+		candidates.clear();
+
+		{
+			STEERIOUSLY_PROFILE_SCOPE(steer::profile::tagObstacles);
+			obstacles.query(agent->getPosition() - extent, agent->getPosition() + extent, candidates);
+		}
+
+		return ObstacleAvoidance(agent, candidates, parameters);
+	}
+
 	/**
 	* \fn	template<class T>
 	*		steer::Vector2 WallAvoidance(const T& agent, const std::vector<steer::Wall*> walls);
@@ -663,7 +827,9 @@ namespace steer //begin steeriously namespace
 	template<class T>
 	steer::Vector2 WallAvoidance(const T& agent, const std::vector<steer::Wall*>& walls)
 	{
-		//the feelers are contained in a std::vector
+		STEERIOUSLY_PROFILE_SCOPE(steer::profile::wallAvoidance);
+
+		//the feelers are held inline in a std::array
 		agent->createFeelers();
 
 		float distance = 0.0;
@@ -676,6 +842,8 @@ namespace steer //begin steeriously namespace
 		steer::Vector2 tempPoint = steer::Vector2(0.0, 0.0);
 		steer::Vector2 point = steer::Vector2(0.0, 0.0);
 
+		STEERIOUSLY_PROFILE_COUNT(steer::profile::wallsTested, agent->getFeelers().size() * walls.size());
+
 		for (unsigned int flr = 0; flr<agent->getFeelers().size(); ++flr)
 		{
 			//for each feeler, check each wall for an intersection point
@@ -715,35 +883,110 @@ namespace steer //begin steeriously namespace
 
 	/**
 	* \fn	template<class T>
-	*		steer::Vector2 pathFollowing(const T& thisAgent, steer::Path& path, const steer::BehaviorParameters& params);
+	*		steer::Vector2 WallAvoidance(const T& agent, const steer::WallIndex& walls);
+	* \brief Same as WallAvoidance over a container, but each feeler only tests the walls in the cells of the index it overlaps.
+	* \param agent - a steer::Agent derived object.
+	* \param walls - a steer::WallIndex.
+	**/
+	template<class T>
+	steer::Vector2 WallAvoidance(const T& agent, const steer::WallIndex& walls)
+	{
+		STEERIOUSLY_PROFILE_SCOPE(steer::profile::wallAvoidance);
+
+		agent->createFeelers();
+
+		float closestDistance = steer::MaxFloat;
+
+		//the closest wall hit by any feeler so far
+		steer::Wall* closest = nullptr;
+
+		steer::Vector2 force = steer::Vector2(0.0, 0.0);
+		steer::Vector2 point = steer::Vector2(0.0, 0.0);
+
+		for (unsigned int flr = 0; flr<agent->getFeelers().size(); ++flr)
+		{
+			steer::WallHit hit;
+
+			if (walls.intersectRay(agent->getPosition(), agent->getFeelers()[flr], hit) && hit.distance < closestDistance)
+			{
+				closestDistance = hit.distance;
+
+				closest = hit.wall;
+
+				point = hit.point;
+			}
+
+			//calculate a force to steer away
+			//from wall if there is an intersection
+			if (closest != nullptr)
+			{
+				//calculate the magnitude the agent
+				//will overshoot the wall by
+				steer::Vector2 over = agent->getFeelers()[flr] - point;
+
+				//create a wall avoidance force
+				//scaled by the overshoot
+				force = closest->Normal() * steer::VectorMath::length(over);
+			}
+		}
+
+		return force;
+	}
+
+	/**
+	* \fn	template<class T>
+	*		steer::Vector2 PathFollowing(const T& agent, steer::PathCursor& cursor, const steer::BehaviorParameters& params);
 	* \brief Given a series of steer::Vector2's, this method produces a force that will move the agent along the way points in order.
+	* <br />Only the cursor is advanced, so any number of agents can follow the same steer::PathData at once, from any thread.
 	* \param agent - a steer::Agent derived object.
-	* \param path - a steer::Path object.
+	* \param cursor - a steer::PathCursor, the agent's progress along the path.
 	* \param params - a steer::BehaviorParameters object.
 	**/
 	template<class T>
-	steer::Vector2 PathFollowing(const T& agent, steer::Path* path, const steer::BehaviorParameters& params)
+	steer::Vector2 PathFollowing(const T& agent, steer::PathCursor& cursor, const steer::BehaviorParameters& params)
 	{
-	    if(path != nullptr)
+		STEERIOUSLY_PROFILE_SCOPE(steer::profile::followPath);
+
+	    if(cursor.valid())
         {
             //continue on to the next waypoint in the path
-            if (steer::VectorMath::distanceSquared(path->currentWaypoint(), agent->getPosition()) < params.waypointSeekDistanceSquared)
+            if (!cursor.finished() && steer::VectorMath::distanceSquared(cursor.currentWaypoint(), agent->getPosition()) < params.waypointSeekDistanceSquared)
             {
-                path->setNextWaypoint();
+                cursor.setNextWaypoint();
             }
 
-            if (!path->finished())
+            if (!cursor.finished())
             {
-                agent->setTarget(path->currentWaypoint());
+                agent->setTarget(cursor.currentWaypoint());
                 return Seek< T >(agent);
             }
 
+            //past the end of an open path, come to rest on the last waypoint
             else
             {
-                agent->setTarget(path->currentWaypoint());
+                agent->setTarget(cursor.getData()->getWaypoint(cursor.getData()->size() - 1));
                 return Arrive< T >(agent, agent->m_deceleration);
             }
         }
+
+        return steer::Vector2(0.0, 0.0);
+	}
+
+	/**
+	* \fn	template<class T>
+	*		steer::Vector2 PathFollowing(const T& agent, steer::Path* path, const steer::BehaviorParameters& params);
+	* \brief Same as PathFollowing on a cursor, advancing the cursor of the path.
+	* \param agent - a steer::Agent derived object.
+	* \param path - a steer::Path object.
+	* \param params - a steer::BehaviorParameters object.
+	**/
+	template<class T>
+	steer::Vector2 PathFollowing(const T& agent, steer::Path* path, const steer::BehaviorParameters& params)
+	{
+	    if(path != nullptr)
+            return PathFollowing(agent, path->getCursor(), params);
+
+        return steer::Vector2(0.0, 0.0);
 	}
 
 } //end namespace steeriously
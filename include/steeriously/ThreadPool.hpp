@@ -0,0 +1,97 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <steeriously/Utilities.hpp>
+
+namespace steer
+{
+    /**
+        \class ThreadPool
+        \brief A small work-stealing pool of threads for splitting loops over agents across cores.
+        <br />parallelFor cuts the index range into chunks and deals them out to one queue per thread.
+        Every thread works through its own queue front to back and, once it runs dry, steals chunks
+        from the back of the other queues, so a thread that drew cheap agents helps out with the rest.
+        The calling thread takes part in the work and parallelFor only returns once every chunk ran.
+    **/
+    class ThreadPool
+    {
+    public:
+
+        /**
+        * \fn ThreadPool(Uint32 threadCount = 0)
+        * \brief Construct a pool and start its threads.
+        * \param threadCount - an Uint32, the number of threads working on a loop including the calling thread. Zero picks the number of hardware threads.
+        **/
+        ThreadPool(Uint32 threadCount = 0);
+
+        /// Destructor - waits for the threads to finish.
+        ~ThreadPool();
+
+        /**
+        * \fn Uint32 getThreadCount() const
+        * \brief Returns the number of threads working on a loop, including the calling thread.
+        **/
+        Uint32 getThreadCount() const { return (Uint32)m_queues.size(); }
+
+        /**
+        * \fn void parallelFor(Uint32 count, Uint32 grain, const std::function<void(Uint32, Uint32)>& job)
+        * \brief Calls job on consecutive ranges [begin, end) covering [0, count) from all threads of the pool and waits for every range to finish.
+        * <br />Ranges run concurrently, so the job must only write state belonging to the indices of its range. Not reentrant.
+        * \param count - an Uint32, the number of indices.
+        * \param grain - an Uint32, the number of indices handed out at once.
+        * \param job - a callable taking the first and one past the last index of a range.
+        **/
+        void parallelFor(Uint32 count, Uint32 grain, const std::function<void(Uint32, Uint32)>& job);
+
+    private:
+
+        //the pool owns running threads, so it is not copyable
+        ThreadPool(const ThreadPool&);
+        ThreadPool& operator=(const ThreadPool&);
+
+        /**
+        * \struct Range
+        * \brief A chunk of indices waiting to be handed to the job.
+        **/
+        struct Range
+        {
+            Uint32  begin;
+            Uint32  end;
+        };
+
+        /**
+        * \struct Queue
+        * \brief The chunks dealt to one thread, the owner pops from the front and thieves from the back.
+        **/
+        struct Queue
+        {
+            std::mutex          mutex;
+            std::deque<Range>   ranges;
+        };
+
+        void workerLoop(Uint32 index);
+
+        bool runOne(Uint32 index);
+
+        std::vector<std::thread>                    m_threads;///< Worker threads, the calling thread is not part of the vector.
+        std::vector< std::unique_ptr<Queue> >       m_queues;///< One queue per thread, the last one belongs to the calling thread.
+        const std::function<void(Uint32, Uint32)>*  m_job;///< Job of the loop currently running.
+        std::atomic<Uint32>                         m_pending;///< Number of ranges of the current loop that have not finished yet.
+        std::mutex                                  m_mutex;///< Guards the generation counter and the quit flag.
+        std::condition_variable                     m_wake;///< Wakes the workers when a loop starts.
+        std::condition_variable                     m_done;///< Wakes the calling thread when the last range finished.
+        Uint64                                      m_generation;///< Incremented on every loop so sleeping workers know there is new work.
+        bool                                        m_quit;///< Tells the workers to exit.
+    };
+}
+
+#endif // THREADPOOL_HPP
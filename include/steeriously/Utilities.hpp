@@ -106,19 +106,177 @@ T Maximum(const T& v1, const T& v2)
 //  some random number functions.
 //----------------------------------------------------------------------------
 
+/**
+*\class RandomStream
+*\brief A counter-based random number generator - every number is a hash of a key, a tick and a counter.
+*<br />Give each agent a stream keyed by its id and re-key it with the tick each frame: the numbers an agent
+*draws then only depend on the agent, the tick and how many it drew before in that tick - not on the order
+*agents are updated in or the thread updating them - so parallel simulations are reproducible and need no locks.
+**/
+class RandomStream
+{
+public:
+
+    /**
+    * \fn RandomStream(Uint64 key = 0, Uint64 tick = 0)
+    * \brief Construct a stream.
+    * \param key - an Uint64, an agent id for example.
+    * \param tick - an Uint64, the frame number for example.
+    **/
+    explicit RandomStream(Uint64 key = 0, Uint64 tick = 0) { seek(key, tick); }
+
+    /**
+    * \fn void seek(Uint64 key, Uint64 tick)
+    * \brief Re-keys the stream and restarts its counter.
+    * \param key - an Uint64.
+    * \param tick - an Uint64.
+    **/
+    void seek(Uint64 key, Uint64 tick)
+    {
+        m_key = key;
+        m_tick = tick;
+        m_stream = mix(key ^ mix(tick));
+        m_counter = 0;
+        m_hasGaussian = false;
+    }
+
+    /**
+    * \fn void setTick(Uint64 tick)
+    * \brief Re-keys the stream with a new tick, keeping the key.
+    * \param tick - an Uint64.
+    **/
+    void setTick(Uint64 tick) { seek(m_key, tick); }
+
+    /**
+    * \fn Uint64 getKey() const
+    * \brief Returns the key of the stream.
+    **/
+    Uint64 getKey() const { return m_key; }
+
+    /**
+    * \fn Uint64 getTick() const
+    * \brief Returns the tick of the stream.
+    **/
+    Uint64 getTick() const { return m_tick; }
+
+    /**
+    * \fn Uint32 nextUint32()
+    * \brief Returns a random 32 bit integer.
+    **/
+    Uint32 nextUint32() { return (Uint32)(mix(m_stream + m_counter++) >> 32); }
+
+    /**
+    * \fn float nextFloat()
+    * \brief Returns a random float between 0 and 1, 1 excluded.
+    **/
+    float nextFloat() { return (nextUint32() >> 8) * (1.f / 16777216.f); }
+
+    /**
+    * \fn float nextClamped()
+    * \brief Returns a random float in the range -1 < n < 1.
+    **/
+    float nextClamped() { return nextFloat() - nextFloat(); }
+
+    /**
+    * \fn float nextInRange(float x, float y)
+    * \brief Returns a random float between x and y.
+    * \param x - a plain old float.
+    * \param y - a plain old float.
+    **/
+    float nextInRange(float x, float y) { return x + nextFloat()*(y-x); }
+
+    /**
+    * \fn int nextInt(int x, int y)
+    * \brief Returns a random integer between x and y.
+    * \param x - a plain old int.
+    * \param y - a plain old int.
+    **/
+    int nextInt(int x, int y) { return (int)(nextUint32() % (Uint32)(y-x+1)) + x; }
+
+    /**
+    * \fn bool nextBool()
+    * \brief Returns true or false randomly.
+    **/
+    bool nextBool() { return (nextUint32() & 0x80000000u) != 0; }
+
+    /**
+    * \fn float nextGaussian(float mean = 0.0, float standard_deviation = 1.0)
+    * \brief Returns a random number with a normal distribution. See method at http://www.taygeta.com/random/gaussian.html.
+    * \param mean - a plain old float.
+    * \param standard_deviation - a plain old float.
+    **/
+    float nextGaussian(float mean = 0.0, float standard_deviation = 1.0)
+    {
+        float y1;
+
+        if (m_hasGaussian)          /* use value from previous call */
+        {
+            y1 = m_gaussian;
+            m_hasGaussian = false;
+        }
+        else
+        {
+            float x1, x2, w;
+
+            do
+            {
+                x1 = 2.0 * nextFloat() - 1.0;
+                x2 = 2.0 * nextFloat() - 1.0;
+                w = x1 * x1 + x2 * x2;
+            }
+            while ( w >= 1.0 || w == 0.0 );
+
+            w = sqrt( (-2.0 * log( w ) ) / w );
+            y1 = x1 * w;
+            m_gaussian = x2 * w;
+            m_hasGaussian = true;
+        }
+
+        return( mean + y1 * standard_deviation );
+    }
+
+private:
+
+    //the splitmix64 finalizer, every bit of the input affects every bit of the output
+    static Uint64 mix(Uint64 z)
+    {
+        z += 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    Uint64  m_key;///< Key the stream was seeked to.
+    Uint64  m_tick;///< Tick the stream was seeked to.
+    Uint64  m_stream;///< Hash of the key and the tick.
+    Uint64  m_counter;///< Number of values drawn since the last seek.
+    float   m_gaussian;///< Second value of the last pair of gaussians.
+    bool    m_hasGaussian;///< Flag to indicate m_gaussian has not been handed out yet.
+};
+
+/**
+    \fn inline steer::RandomStream& ThreadRandomStream();
+    \brief Returns the stream of the calling thread, which the free random functions below draw from. Seek it to seed them.
+**/
+inline RandomStream& ThreadRandomStream()
+{
+    static thread_local RandomStream stream;
+    return stream;
+}
+
 /**
     \fn inline int RandInt(int x,int y);
     \brief Returns a random integer between x and y.
     \param x - a plain old int.
     \param y - a plain old int.
 **/
-inline int RandInt(int x,int y) {return rand()%(y-x+1)+x;}
+inline int RandInt(int x,int y) {return ThreadRandomStream().nextInt(x, y);}
 
 /**
     \fn inline float RandFloat();
-    \brief Returns a random float between 1 and the maximum value for a float.
+    \brief Returns a random float between 0 and 1, 1 excluded.
 **/
-inline float RandFloat(){return ((rand())/(RAND_MAX+1.0));}
+inline float RandFloat(){return ThreadRandomStream().nextFloat();}
 
 /**
     \fn inline float RandInRange(float x, float y);
@@ -128,7 +286,19 @@ inline float RandFloat(){return ((rand())/(RAND_MAX+1.0));}
 **/
 inline float RandInRange(float x, float y)
 {
-  return x + RandFloat()*(y-x);
+  return ThreadRandomStream().nextInRange(x, y);
+}
+
+/**
+    \fn inline float RandInRange(steer::RandomStream& stream, float x, float y);
+    \brief Returns a random float between x and y drawn from a stream.
+    \param stream - a steer::RandomStream.
+    \param x - a plain old float.
+    \param y - a plain old float.
+**/
+inline float RandInRange(RandomStream& stream, float x, float y)
+{
+  return stream.nextInRange(x, y);
 }
 
 /**
@@ -137,16 +307,14 @@ inline float RandInRange(float x, float y)
 **/
 inline bool   RandBool()
 {
-  if (RandInt(0,1)) return true;
-
-  else return false;
+  return ThreadRandomStream().nextBool();
 }
 
 /**
     \fn inline float RandomClamped();
     \brief Returns a random float in the range -1 < n < 1.
 **/
-inline float RandomClamped(){return RandFloat() - RandFloat();}
+inline float RandomClamped(){return ThreadRandomStream().nextClamped();}
 
 /**
     \fn inline float RandGaussian(float mean = 0.0, float standard_deviation = 1.0);
@@ -156,32 +324,7 @@ inline float RandomClamped(){return RandFloat() - RandFloat();}
 **/
 inline float RandGaussian(float mean = 0.0, float standard_deviation = 1.0)
 {
-	float x1, x2, w, y1;
-	static float y2;
-	static int use_last = 0;
-
-	if (use_last)		        /* use value from previous call */
-	{
-		y1 = y2;
-		use_last = 0;
-	}
-	else
-	{
-		do
-        {
-			x1 = 2.0 * RandFloat() - 1.0;
-			x2 = 2.0 * RandFloat() - 1.0;
-			w = x1 * x1 + x2 * x2;
-		}
-        while ( w >= 1.0 );
-
-            w = sqrt( (-2.0 * log( w ) ) / w );
-            y1 = x1 * w;
-            y2 = x2 * w;
-            use_last = 1;
-	}
-
-	return( mean + y1 * standard_deviation );
+	return ThreadRandomStream().nextGaussian(mean, standard_deviation);
 }
 
 //-----------------------------------------------------------------------
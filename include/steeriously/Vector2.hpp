@@ -12,48 +12,59 @@ namespace steer
 
 
 /**
-*\struct Vector2
-*\brief A 2D vector struct used in many steering calculations.
+*\struct BasicVector2
+*\brief A 2D vector struct used in many steering calculations, templated on its scalar type.
+*<br />Use the steer::Vector2f and steer::Vector2d typedefs, or steer::Vector2 for the precision the library is built with.
 **/
-struct Vector2
+template <typename T>
+struct BasicVector2
 {
-  double x;
-  double y;
+  typedef T value_type;///< The scalar type of the components.
+
+  T x;
+  T y;
 
     /**
-		* \fn Vector2();
+		* \fn BasicVector2();
 		* \brief Default constructor
     **/
-    Vector2():x(0.0),y(0.0){}
-    Vector2(double a, double b):x(a),y(b){}
+    BasicVector2():x(T(0)),y(T(0)){}
+    BasicVector2(T a, T b):x(a),y(b){}
+
+    /**
+		* \fn template <typename U> explicit BasicVector2(const BasicVector2<U>& v);
+		* \brief Converts a vector of another precision.
+    **/
+    template <typename U>
+    explicit BasicVector2(const BasicVector2<U>& v):x(T(v.x)),y(T(v.y)){}
 
     //sets x and y to zero
     /**
 		* \fn Zero();
 		* \brief Set both x and y values to zero.
     **/
-    void Zero(){x=0.0; y=0.0;}
+    void Zero(){x=T(0); y=T(0);}
 
     //returns true if both x and y are zero
     /**
 		* \fn bool isZero() const;
 		* \brief Returns true if both x and y values are zero.
     **/
-    bool isZero() const {return (x*x + y*y) < MinDouble;}
+    bool isZero() const {return (x*x + y*y) < (std::numeric_limits<T>::min)();}
 
     //returns the length of the vector
     /**
-		* \fn inline double Length() const;
+		* \fn inline T Length() const;
 		* \brief Returns the length of the vector.
     **/
-    inline double Length()const;
+    inline T Length()const;
 
     //returns the squared length of the vector (thereby avoiding the sqrt)
     /**
-		* \fn inline double LengthSq() const;
+		* \fn inline T LengthSq() const;
 		* \brief Returns the squared length of the vector (thereby avoiding sqrt).
     **/
-    inline double LengthSq() const;
+    inline T LengthSq() const;
 
     /**
 		* \fn inline void Normalize();
@@ -62,44 +73,44 @@ struct Vector2
     inline void Normalize();
 
     /**
-		* \fn inline double Dot(const Vector2& v2) const;
+		* \fn inline T Dot(const BasicVector2& v2) const;
 		* \brief Returns the dot product of the vector.
     **/
-    inline double Dot(const Vector2& v2) const;
+    inline T Dot(const BasicVector2& v2) const;
 
     //returns positive if v2 is clockwise of this vector,
     //negative if anticlockwise (assuming the Y axis is pointing down,
     //X axis to right like a Window app)
     /**
-		* \fn inline int Sign(const Vector2& v2) const;
+		* \fn inline int Sign(const BasicVector2& v2) const;
 		* \brief Returns positive if v2 is clockwise of this vector, negative if anticlockwise (assuming y-axis is pointing down and x-axis is pointing right).
     **/
-    inline int Sign(const Vector2& v2) const;
+    inline int Sign(const BasicVector2& v2) const;
 
     //returns the vector that is perpendicular to this one.
     /**
-		* \fn inline Vector2 Perp() const;
+		* \fn inline BasicVector2 Perp() const;
 		* \brief Returns the vector that is perpendicular to this vector.
     **/
-    inline Vector2 Perp() const;
+    inline BasicVector2 Perp() const;
 
   //adjusts x and y so that the length of the vector does not exceed max
-  inline void      Truncate(double max);
+  inline void      Truncate(T max);
 
   //returns the distance between this vector and th one passed as a parameter
-  inline double    Distance(const Vector2 &v2)const;
+  inline T         Distance(const BasicVector2 &v2)const;
 
   //squared version of above.
-  inline double    DistanceSq(const Vector2 &v2)const;
+  inline T         DistanceSq(const BasicVector2 &v2)const;
 
-  inline void      Reflect(const Vector2& norm);
+  inline void      Reflect(const BasicVector2& norm);
 
   //returns the vector that is the reverse of this vector
-  inline Vector2  GetReverse()const;
+  inline BasicVector2  GetReverse()const;
 
 
   //we need some overloaded operators
-  const Vector2& operator+=(const Vector2 &rhs)
+  const BasicVector2& operator+=(const BasicVector2 &rhs)
   {
     x += rhs.x;
     y += rhs.y;
@@ -107,7 +118,7 @@ struct Vector2
     return *this;
   }
 
-  const Vector2& operator-=(const Vector2 &rhs)
+  const BasicVector2& operator-=(const BasicVector2 &rhs)
   {
     x -= rhs.x;
     y -= rhs.y;
@@ -115,7 +126,7 @@ struct Vector2
     return *this;
   }
 
-  const Vector2& operator*=(const double& rhs)
+  const BasicVector2& operator*=(const T& rhs)
   {
     x *= rhs;
     y *= rhs;
@@ -123,7 +134,7 @@ struct Vector2
     return *this;
   }
 
-  const Vector2& operator/=(const double& rhs)
+  const BasicVector2& operator/=(const T& rhs)
   {
     x /= rhs;
     y /= rhs;
@@ -131,24 +142,74 @@ struct Vector2
     return *this;
   }
 
-  bool operator==(const Vector2& rhs)const
+  bool operator==(const BasicVector2& rhs)const
   {
     return (isEqual(x, rhs.x) && isEqual(y,rhs.y) );
   }
 
-  bool operator!=(const Vector2& rhs)const
+  bool operator!=(const BasicVector2& rhs)const
   {
     return (x != rhs.x) || (y != rhs.y);
   }
 
+  //the remaining operators are friends defined in the class, so they are only
+  //found for vectors and any scalar converts to the scalar type of the vector
+  friend BasicVector2 operator*(const BasicVector2 &lhs, T rhs)
+  {
+    BasicVector2 result(lhs);
+    result *= rhs;
+    return result;
+  }
+
+  friend BasicVector2 operator*(T lhs, const BasicVector2 &rhs)
+  {
+    BasicVector2 result(rhs);
+    result *= lhs;
+    return result;
+  }
+
+  //overload the - operator
+  friend BasicVector2 operator-(const BasicVector2 &lhs, const BasicVector2 &rhs)
+  {
+    BasicVector2 result(lhs);
+    result.x -= rhs.x;
+    result.y -= rhs.y;
+
+    return result;
+  }
+
+  //overload the + operator
+  friend BasicVector2 operator+(const BasicVector2 &lhs, const BasicVector2 &rhs)
+  {
+    BasicVector2 result(lhs);
+    result.x += rhs.x;
+    result.y += rhs.y;
+
+    return result;
+  }
+
+  //overload the / operator
+  friend BasicVector2 operator/(const BasicVector2 &lhs, T val)
+  {
+    BasicVector2 result(lhs);
+    result.x /= val;
+    result.y /= val;
+
+    return result;
+  }
+
 };
 
-//-----------------------------------------------------------------------some more operator overloads
-inline Vector2 operator*(const Vector2 &lhs, double rhs);
-inline Vector2 operator*(double lhs, const Vector2 &rhs);
-inline Vector2 operator-(const Vector2 &lhs, const Vector2 &rhs);
-inline Vector2 operator+(const Vector2 &lhs, const Vector2 &rhs);
-inline Vector2 operator/(const Vector2 &lhs, double val);
+///< Vectors of floats and doubles.
+typedef BasicVector2<float>  Vector2f;
+typedef BasicVector2<double> Vector2d;
+
+///< The vector used throughout the library - doubles, or floats when built with STEERIOUSLY_USE_FLOAT defined.
+#ifdef STEERIOUSLY_USE_FLOAT
+typedef Vector2f Vector2;
+#else
+typedef Vector2d Vector2;
+#endif
 
 //------------------------------------------------------------------------member functions
 
@@ -156,7 +217,8 @@ inline Vector2 operator/(const Vector2 &lhs, double val);
 //
 //  returns the length of a 2D vector
 //------------------------------------------------------------------------
-inline double Vector2::Length()const
+template <typename T>
+inline T BasicVector2<T>::Length()const
 {
   return sqrt(x * x + y * y);
 }
@@ -166,7 +228,8 @@ inline double Vector2::Length()const
 //
 //  returns the squared length of a 2D vector
 //------------------------------------------------------------------------
-inline double Vector2::LengthSq()const
+template <typename T>
+inline T BasicVector2<T>::LengthSq()const
 {
   return (x * x + y * y);
 }
@@ -176,7 +239,8 @@ inline double Vector2::LengthSq()const
 //
 //  calculates the dot product
 //------------------------------------------------------------------------
-inline double Vector2::Dot(const Vector2 &v2)const
+template <typename T>
+inline T BasicVector2<T>::Dot(const BasicVector2<T> &v2)const
 {
   return x*v2.x + y*v2.y;
 }
@@ -188,7 +252,8 @@ inline double Vector2::Dot(const Vector2 &v2)const
 //------------------------------------------------------------------------
 enum {clockwise = 1, anticlockwise = -1};
 
-inline int Vector2::Sign(const Vector2& v2)const
+template <typename T>
+inline int BasicVector2<T>::Sign(const BasicVector2<T>& v2)const
 {
   if (y*v2.x > x*v2.y)
   {
@@ -204,19 +269,21 @@ inline int Vector2::Sign(const Vector2& v2)const
 //
 //  Returns a vector perpendicular to this vector
 //------------------------------------------------------------------------
-inline Vector2 Vector2::Perp()const
+template <typename T>
+inline BasicVector2<T> BasicVector2<T>::Perp()const
 {
-  return Vector2(-y, x);
+  return BasicVector2<T>(-y, x);
 }
 
 //------------------------------ Distance --------------------------------
 //
 //  calculates the euclidean distance between two vectors
 //------------------------------------------------------------------------
-inline double Vector2::Distance(const Vector2 &v2)const
+template <typename T>
+inline T BasicVector2<T>::Distance(const BasicVector2<T> &v2)const
 {
-  double ySeparation = v2.y - y;
-  double xSeparation = v2.x - x;
+  T ySeparation = v2.y - y;
+  T xSeparation = v2.x - x;
 
   return sqrt(ySeparation*ySeparation + xSeparation*xSeparation);
 }
@@ -226,10 +293,11 @@ inline double Vector2::Distance(const Vector2 &v2)const
 //
 //  calculates the euclidean distance squared between two vectors
 //------------------------------------------------------------------------
-inline double Vector2::DistanceSq(const Vector2 &v2)const
+template <typename T>
+inline T BasicVector2<T>::DistanceSq(const BasicVector2<T> &v2)const
 {
-  double ySeparation = v2.y - y;
-  double xSeparation = v2.x - x;
+  T ySeparation = v2.y - y;
+  T xSeparation = v2.x - x;
 
   return ySeparation*ySeparation + xSeparation*xSeparation;
 }
@@ -238,7 +306,8 @@ inline double Vector2::DistanceSq(const Vector2 &v2)const
 //
 //  truncates a vector so that its length does not exceed max
 //------------------------------------------------------------------------
-inline void Vector2::Truncate(double max)
+template <typename T>
+inline void BasicVector2<T>::Truncate(T max)
 {
   if (this->Length() > max)
   {
@@ -253,18 +322,20 @@ inline void Vector2::Truncate(double max)
 //  given a normalized vector this method reflects the vector it
 //  is operating upon. (like the path of a ball bouncing off a wall)
 //------------------------------------------------------------------------
-inline void Vector2::Reflect(const Vector2& norm)
+template <typename T>
+inline void BasicVector2<T>::Reflect(const BasicVector2<T>& norm)
 {
-  *this += 2.0 * this->Dot(norm) * norm.GetReverse();
+  *this += T(2) * this->Dot(norm) * norm.GetReverse();
 }
 
 //----------------------- GetReverse ----------------------------------------
 //
 //  returns the vector that is the reverse of this vector
 //------------------------------------------------------------------------
-inline Vector2 Vector2::GetReverse()const
+template <typename T>
+inline BasicVector2<T> BasicVector2<T>::GetReverse()const
 {
-  return Vector2(-this->x, -this->y);
+  return BasicVector2<T>(-this->x, -this->y);
 }
 
 
@@ -272,11 +343,12 @@ inline Vector2 Vector2::GetReverse()const
 //
 //  normalizes a 2D Vector
 //------------------------------------------------------------------------
-inline void Vector2::Normalize()
+template <typename T>
+inline void BasicVector2<T>::Normalize()
 {
-  double vector_length = this->Length();
+  T vector_length = this->Length();
 
-  if (vector_length > std::numeric_limits<double>::epsilon())
+  if (vector_length > std::numeric_limits<T>::epsilon())
   {
     this->x /= vector_length;
     this->y /= vector_length;
@@ -286,13 +358,14 @@ inline void Vector2::Normalize()
 
 //------------------------------------------------------------------------non member functions
 
-inline Vector2 Vec2DNormalize(const Vector2 &v)
+template <typename T>
+inline BasicVector2<T> Vec2DNormalize(const BasicVector2<T> &v)
 {
-  Vector2 vec = v;
+  BasicVector2<T> vec = v;
 
-  double vector_length = vec.Length();
+  T vector_length = vec.Length();
 
-  if (vector_length > std::numeric_limits<double>::epsilon())
+  if (vector_length > std::numeric_limits<T>::epsilon())
   {
     vec.x /= vector_length;
     vec.y /= vector_length;
@@ -302,114 +375,76 @@ inline Vector2 Vec2DNormalize(const Vector2 &v)
 }
 
 
-inline double Vec2DDistance(const Vector2 &v1, const Vector2 &v2)
+template <typename T>
+inline T Vec2DDistance(const BasicVector2<T> &v1, const BasicVector2<T> &v2)
 {
 
-  double ySeparation = v2.y - v1.y;
-  double xSeparation = v2.x - v1.x;
+  T ySeparation = v2.y - v1.y;
+  T xSeparation = v2.x - v1.x;
 
   return sqrt(ySeparation*ySeparation + xSeparation*xSeparation);
 }
 
-inline double Vec2DDistanceSq(const Vector2 &v1, const Vector2 &v2)
+template <typename T>
+inline T Vec2DDistanceSq(const BasicVector2<T> &v1, const BasicVector2<T> &v2)
 {
 
-  double ySeparation = v2.y - v1.y;
-  double xSeparation = v2.x - v1.x;
+  T ySeparation = v2.y - v1.y;
+  T xSeparation = v2.x - v1.x;
 
   return ySeparation*ySeparation + xSeparation*xSeparation;
 }
 
-inline double Vec2DLength(const Vector2& v)
+template <typename T>
+inline T Vec2DLength(const BasicVector2<T>& v)
 {
   return sqrt(v.x*v.x + v.y*v.y);
 }
 
-inline double Vec2DLengthSq(const Vector2& v)
+template <typename T>
+inline T Vec2DLengthSq(const BasicVector2<T>& v)
 {
   return (v.x*v.x + v.y*v.y);
 }
 
-
-//------------------------------------------------------------------------operator overloads
-inline Vector2 operator*(const Vector2 &lhs, double rhs)
-{
-  Vector2 result(lhs);
-  result *= rhs;
-  return result;
-}
-
-inline Vector2 operator*(double lhs, const Vector2 &rhs)
-{
-  Vector2 result(rhs);
-  result *= lhs;
-  return result;
-}
-
-//overload the - operator
-inline Vector2 operator-(const Vector2 &lhs, const Vector2 &rhs)
-{
-  Vector2 result(lhs);
-  result.x -= rhs.x;
-  result.y -= rhs.y;
-
-  return result;
-}
-
-//overload the + operator
-inline Vector2 operator+(const Vector2 &lhs, const Vector2 &rhs)
-{
-  Vector2 result(lhs);
-  result.x += rhs.x;
-  result.y += rhs.y;
-
-  return result;
-}
-
-//overload the / operator
-inline Vector2 operator/(const Vector2 &lhs, double val)
-{
-  Vector2 result(lhs);
-  result.x /= val;
-  result.y /= val;
-
-  return result;
-}
-
 ///////////////////////////////////////////////////////////////////////////////
 
 
 //treats a window as a toroid
-inline void WrapAround(Vector2 &pos, int MaxX, int MaxY)
+template <typename T>
+inline void WrapAround(BasicVector2<T> &pos, int MaxX, int MaxY)
 {
-  if (pos.x > MaxX) {pos.x = 0.0;}
+  if (pos.x > MaxX) {pos.x = T(0);}
 
-  if (pos.x < 0)    {pos.x = (double)MaxX;}
+  if (pos.x < 0)    {pos.x = (T)MaxX;}
 
-  if (pos.y < 0)    {pos.y = (double)MaxY;}
+  if (pos.y < 0)    {pos.y = (T)MaxY;}
 
-  if (pos.y > MaxY) {pos.y = 0.0;}
+  if (pos.y > MaxY) {pos.y = T(0);}
 }
 
 //returns true if the point p is not inside the region defined by top_left
 //and bot_rgt
-inline bool NotInsideRegion(Vector2 p,
-                            Vector2 top_left,
-                            Vector2 bot_rgt)
+template <typename T>
+inline bool NotInsideRegion(BasicVector2<T> p,
+                            BasicVector2<T> top_left,
+                            BasicVector2<T> bot_rgt)
 {
   return (p.x < top_left.x) || (p.x > bot_rgt.x) ||
          (p.y < top_left.y) || (p.y > bot_rgt.y);
 }
 
-inline bool InsideRegion(Vector2 p,
-                         Vector2 top_left,
-                         Vector2 bot_rgt)
+template <typename T>
+inline bool InsideRegion(BasicVector2<T> p,
+                         BasicVector2<T> top_left,
+                         BasicVector2<T> bot_rgt)
 {
   return !((p.x < top_left.x) || (p.x > bot_rgt.x) ||
          (p.y < top_left.y) || (p.y > bot_rgt.y));
 }
 
-inline bool InsideRegion(Vector2 p, int left, int top, int right, int bottom)
+template <typename T>
+inline bool InsideRegion(BasicVector2<T> p, int left, int top, int right, int bottom)
 {
   return !( (p.x < left) || (p.x > right) || (p.y < top) || (p.y > bottom) );
 }
@@ -417,16 +452,18 @@ inline bool InsideRegion(Vector2 p, int left, int top, int right, int bottom)
 //------------------ isSecondInFOVOfFirst -------------------------------------
 //
 //  returns true if the target position is in the field of view of the entity
-//  positioned at posFirst facing in facingFirst
+//  positioned at posFirst facing in facingFirst. The angle takes any
+//  arithmetic type, so float and double literals both work
 //-----------------------------------------------------------------------------
-inline bool isSecondInFOVOfFirst(Vector2 posFirst,
-                                 Vector2 facingFirst,
-                                 Vector2 posSecond,
-                                 double    fov)
+template <typename T, typename F>
+inline bool isSecondInFOVOfFirst(BasicVector2<T> posFirst,
+                                 BasicVector2<T> facingFirst,
+                                 BasicVector2<T> posSecond,
+                                 F    fov)
 {
-  Vector2 toTarget = Vec2DNormalize(posSecond - posFirst);
+  BasicVector2<T> toTarget = Vec2DNormalize(posSecond - posFirst);
 
-  return facingFirst.Dot(toTarget) >= cos(fov/2.0);
+  return facingFirst.Dot(toTarget) >= cos(T(fov)/T(2));
 }
 
 }
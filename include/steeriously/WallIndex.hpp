@@ -0,0 +1,103 @@
+#ifndef WALLINDEX_HPP
+#define WALLINDEX_HPP
+
+#include <vector>
+
+#include <steeriously/Utilities.hpp>
+#include <steeriously/Vector2.hpp>
+#include <steeriously/Wall.hpp>
+
+namespace steer
+{
+    /**
+    *\struct WallHit
+    *\brief The nearest wall a ray hits, filled in by steer::WallIndex::intersectRay.
+    **/
+    struct WallHit
+    {
+        steer::Wall*    wall;///< The wall that was hit.
+        float           distance;///< Distance from the start of the ray to the hit, same as steer::LineIntersection2D returns.
+        steer::Vector2  point;///< Where the ray hits the wall.
+    };
+
+    /**
+        \class WallIndex
+        \brief A uniform grid over static steer::Wall segments.
+        <br />Every cell holds the segments crossing it in one contiguous run of flat arrays, so a ray
+        (a feeler) only tests the segments of the few cells it overlaps instead of every wall in the level.
+        <br />The end points are copied when the index is built - call build again after moving a wall.
+    **/
+    class WallIndex
+    {
+    public:
+
+        /**
+        * \fn WallIndex()
+        * \brief Construct an empty index.
+        **/
+        WallIndex();
+
+        /**
+        * \fn WallIndex(const std::vector<steer::Wall*>& walls, float cellSize = 0.f)
+        * \brief Construct an index over the walls.
+        * \param walls - a std::vector of steer::Wall pointers, which must outlive the index.
+        * \param cellSize - a plain old float, zero picks one from the number of walls and the area they cover.
+        **/
+        explicit WallIndex(const std::vector<steer::Wall*>& walls, float cellSize = 0.f);
+
+        /**
+        * \fn void build(const std::vector<steer::Wall*>& walls, float cellSize = 0.f)
+        * \brief Rebuilds the index over the walls, null pointers are skipped.
+        * \param walls - a std::vector of steer::Wall pointers, which must outlive the index.
+        * \param cellSize - a plain old float, zero picks one from the number of walls and the area they cover.
+        **/
+        void build(const std::vector<steer::Wall*>& walls, float cellSize = 0.f);
+
+        /**
+        * \fn bool intersectRay(steer::Vector2 from, steer::Vector2 to, steer::WallHit& hit) const
+        * \brief Finds the wall nearest to from that the segment from-to crosses. Of walls hit at the same distance, the one first in the container wins.
+        * \param from - a steer::Vector2, start of the ray.
+        * \param to - a steer::Vector2, end of the ray.
+        * \param hit - a steer::WallHit, only written when a wall was hit.
+        **/
+        bool intersectRay(steer::Vector2 from, steer::Vector2 to, steer::WallHit& hit) const;
+
+        /**
+        * \fn float getCellSize() const
+        * \brief Returns the length of a side of a cell.
+        **/
+        float getCellSize() const { return m_cellSize; }
+
+        /**
+        * \fn Uint32 size() const
+        * \brief Returns the number of walls in the index.
+        **/
+        Uint32 size() const { return (Uint32)m_walls.size(); }
+
+        /**
+        * \fn bool empty() const
+        * \brief Returns true if the index holds no walls.
+        **/
+        bool empty() const { return m_walls.empty(); }
+
+    private:
+
+        Int32 cellCoord(float value, float origin, Int32 numCells) const;
+
+        std::vector<steer::Wall*>   m_walls;///< The indexed walls, in the order of the container the index was built from.
+        std::vector<Uint32>         m_cellStart;///< Where the run of each cell starts, cell i holds segments m_cellStart[i] to m_cellStart[i + 1].
+        std::vector<float>          m_fromX;///< x of the start of each segment, grouped by cell.
+        std::vector<float>          m_fromY;///< y of the start of each segment, grouped by cell.
+        std::vector<float>          m_toX;///< x of the end of each segment, grouped by cell.
+        std::vector<float>          m_toY;///< y of the end of each segment, grouped by cell.
+        std::vector<Uint32>         m_wallIndex;///< Index into m_walls of each segment, grouped by cell.
+        float                       m_originX;///< Left edge of the grid.
+        float                       m_originY;///< Top edge of the grid.
+        float                       m_cellSize;///< Length of a side of a cell.
+        float                       m_inverseCellSize;///< Cached reciprocal of the cell size.
+        Int32                       m_numCellsX;///< Number of columns.
+        Int32                       m_numCellsY;///< Number of rows.
+    };
+}
+
+#endif // WALLINDEX_HPP
@@ -0,0 +1,363 @@
+#ifndef WORLD_HPP
+#define WORLD_HPP
+
+#include <functional>
+#include <list>
+#include <vector>
+
+#include <steeriously/AgentRegistry.hpp>
+#include <steeriously/AgentStore.hpp>
+#include <steeriously/ArchetypeTable.hpp>
+#include <steeriously/BehaviorData.hpp>
+#include <steeriously/LodScheduler.hpp>
+#include <steeriously/ObjectPool.hpp>
+#include <steeriously/ObstacleIndex.hpp>
+#include <steeriously/Path.hpp>
+#include <steeriously/SpatialHashGrid.hpp>
+#include <steeriously/SphereObstacle.hpp>
+#include <steeriously/ThreadPool.hpp>
+#include <steeriously/Vector2.hpp>
+#include <steeriously/Wall.hpp>
+#include <steeriously/WallIndex.hpp>
+#include <steeriously/components/SuperComponent.hpp>
+
+namespace steer
+{
+    //SuperComponent.hpp pulls in libinc.hpp, which includes this file
+    class SuperComponent;
+
+    /**
+        \class World
+        \brief Owns a population of agents along with the obstacles, walls and paths they steer around,
+        and updates all of them in one staged pass.
+        <br />Instead of calling Update on each agent in turn, step() refreshes the spatial index once,
+        computes the steering force of every agent and only then integrates every agent. Because no
+        agent moves before all forces are known, every agent steers against the same frame.
+    **/
+    class World
+    {
+    public:
+
+        /**
+        * \fn World(steer::BehaviorParameters* params)
+        * \brief Construct a world. The parameters pick the cell size of the spatial index and are handed to agents created by the world.
+        * \param params - a pointer to a steer::BehaviorParameters object, must outlive the world.
+        **/
+        World(steer::BehaviorParameters* params);
+
+        /// Destructor - destroys every agent, obstacle, wall and path owned by the world.
+        ~World();
+
+        /**
+        * \fn steer::SuperComponent* createAgent()
+        * \brief Creates an agent from the world's parameters in the world's agent pool and adds it to the world.
+        **/
+        steer::SuperComponent* createAgent();
+
+        /**
+        * \fn steer::SuperComponent* createAgent(steer::BehaviorParameters* params)
+        * \brief Creates an agent from a separate set of parameters in the world's agent pool and adds it to the world.
+        * \param params - a pointer to a steer::BehaviorParameters object, must outlive the agent.
+        **/
+        steer::SuperComponent* createAgent(steer::BehaviorParameters* params);
+
+        /**
+        * \fn void addAgent(steer::SuperComponent* agent)
+        * \brief Adds an agent allocated with new to the world, which takes ownership of it, registers it for a handle and hands it the world's neighbors, obstacles, walls and spatial index.
+        * \param agent - a pointer to a steer::SuperComponent.
+        **/
+        void addAgent(steer::SuperComponent* agent);
+
+        /**
+        * \fn void removeAgent(steer::SuperComponent* agent)
+        * \brief Removes and destroys an agent, handing its slot back to the pool if the world created it. Agents pursuing, evading, hiding from, following or interposing the removed agent lose that target, and its handles resolve to null.
+        * <br />Takes constant time, the last agent of the list takes the removed agent's place. Targets are followed by handle, and a target
+        * set by pointer before its agent joined the world only picks up the handle on the next step - remove such an agent before then and
+        * clearing those targets is up to the caller.
+        * \param agent - a pointer to a steer::SuperComponent owned by the world.
+        **/
+        void removeAgent(steer::SuperComponent* agent);
+
+        /**
+        * \fn steer::SuperComponent* getAgent(steer::AgentHandle handle) const
+        * \brief Returns the agent of the world a handle names, null once it was removed.
+        * \param handle - a steer::AgentHandle, see Agent::getHandle.
+        **/
+        steer::SuperComponent* getAgent(steer::AgentHandle handle) const;
+
+        /**
+        * \fn steer::AgentRef getRef(steer::AgentHandle handle) const
+        * \brief Returns a reference to the agent of the world a handle names, to hand to the target setters of other agents. It resolves to null once the agent was removed.
+        * \param handle - a steer::AgentHandle, see Agent::getHandle.
+        **/
+        steer::AgentRef getRef(steer::AgentHandle handle) const { return steer::AgentRef(m_registry, handle); }
+
+        /**
+        * \fn void defragment()
+        * \brief Moves the agents created by the world into as few chunks of its pool as they fit in, ordered by the cell of the spatial index they sit in,
+        * so agents close to each other are close in memory. Holes left by removed agents are closed.
+        * <br />Agents change address and getAgents() changes order, but their handles and the targets of other agents follow them.
+        * The neighbors each agent gathered are dropped and gathered again on the next step.
+        * Call it between steps, e.g. every few seconds when agents come and go or move across the world.
+        **/
+        void defragment();
+
+        /**
+        * \fn steer::SphereObstacle* createObstacle(steer::Vector2 position, float radius)
+        * \brief Creates an obstacle in the world's obstacle pool and adds it to the world.
+        * \param position - a steer::Vector2 of floats.
+        * \param radius - a plain old float.
+        **/
+        steer::SphereObstacle* createObstacle(steer::Vector2 position, float radius);
+
+        /**
+        * \fn void addObstacle(steer::SphereObstacle* obstacle)
+        * \brief Adds an obstacle allocated with new to the world, which takes ownership of it.
+        * \param obstacle - a pointer to a steer::SphereObstacle.
+        **/
+        void addObstacle(steer::SphereObstacle* obstacle);
+
+        /**
+        * \fn void removeObstacle(steer::SphereObstacle* obstacle)
+        * \brief Removes and destroys an obstacle, handing its slot back to the pool if the world created it.
+        * \param obstacle - a pointer to a steer::SphereObstacle owned by the world.
+        **/
+        void removeObstacle(steer::SphereObstacle* obstacle);
+
+        /**
+        * \fn steer::Wall* createWall(steer::Vector2 from, steer::Vector2 to)
+        * \brief Creates a wall in the world's wall pool and adds it to the world.
+        * \param from - a steer::Vector2 of floats.
+        * \param to - a steer::Vector2 of floats.
+        **/
+        steer::Wall* createWall(steer::Vector2 from, steer::Vector2 to);
+
+        /**
+        * \fn void addWall(steer::Wall* wall)
+        * \brief Adds a wall allocated with new to the world, which takes ownership of it.
+        * \param wall - a pointer to a steer::Wall.
+        **/
+        void addWall(steer::Wall* wall);
+
+        /**
+        * \fn void removeWall(steer::Wall* wall)
+        * \brief Removes and destroys a wall, handing its slot back to the pool if the world created it.
+        * \param wall - a pointer to a steer::Wall owned by the world.
+        **/
+        void removeWall(steer::Wall* wall);
+
+        /**
+        * \fn steer::Path* createPath(std::list<steer::Vector2>& waypoints)
+        * \brief Creates a path from a list of waypoints and adds it to the world.
+        * \param waypoints - a std::list of steer::Vector2.
+        **/
+        steer::Path* createPath(std::list<steer::Vector2>& waypoints);
+
+        /**
+        * \fn steer::Path* createPath(const std::vector<steer::Vector2>& waypoints)
+        * \brief Creates a path from a vector of waypoints and adds it to the world.
+        * \param waypoints - a std::vector of steer::Vector2.
+        **/
+        steer::Path* createPath(const std::vector<steer::Vector2>& waypoints);
+
+        /**
+        * \fn void addPath(steer::Path* path)
+        * \brief Adds a path allocated with new to the world, which takes ownership of it.
+        * \param path - a pointer to a steer::Path.
+        **/
+        void addPath(steer::Path* path);
+
+        /**
+        * \fn void removePath(steer::Path* path)
+        * \brief Removes and deletes a path. Agents following it, or its waypoints through setPathData, stop following a path.
+        * \param path - a pointer to a steer::Path owned by the world.
+        **/
+        void removePath(steer::Path* path);
+
+        /**
+        * \fn void reserve(Uint32 agents, Uint32 obstacles, Uint32 walls)
+        * \brief Grows the pools and lists of the world up front, so creating and removing up to that many agents, obstacles and walls allocates nothing.
+        * \param agents - an Uint32.
+        * \param obstacles - an Uint32.
+        * \param walls - an Uint32.
+        **/
+        void reserve(Uint32 agents, Uint32 obstacles, Uint32 walls);
+
+        /**
+        * \fn void setThreadCount(Uint32 count)
+        * \brief Sets the number of threads step() spreads the force computation and integration over, the calling thread included.
+        * <br />One (the default) keeps everything on the calling thread, zero picks the number of hardware threads.
+        * Re-binning agents in the spatial index always runs on the calling thread.
+        * \param count - an Uint32.
+        **/
+        void setThreadCount(Uint32 count);
+
+        /**
+        * \fn Uint32 getThreadCount() const
+        * \brief Returns the number of threads step() runs on.
+        **/
+        Uint32 getThreadCount() const;
+
+        /**
+        * \fn void step(float dt)
+        * \brief Advances every agent by dt: refreshes the spatial index, computes all steering forces, then integrates all agents.
+        * <br />Agents at rest then fall asleep and are skipped by later steps until their target changes or starts moving, a force is applied to them or a moving agent comes within view.
+        * \param dt - a plain old float.
+        **/
+        void step(float dt);
+
+        /**
+        * \fn void setLodScheduler(steer::LodScheduler* scheduler)
+        * \brief Sets the scheduler picking which agents recompute their steering force on a step. Agents that are not due keep integrating with their last force.
+        * \param scheduler - a pointer to a steer::LodScheduler, which must outlive the world, or null to update every agent on every step.
+        **/
+        void setLodScheduler(steer::LodScheduler* scheduler) { m_lodScheduler = scheduler; }
+
+        /**
+        * \fn steer::LodScheduler* getLodScheduler()
+        * \brief Returns the level of detail scheduler, null if none.
+        **/
+        steer::LodScheduler* getLodScheduler() { return m_lodScheduler; }
+
+        /**
+        * \fn void setArchetypeWindow(Uint32 window)
+        * \brief Sets how many consecutive awake agents are grouped by archetype when computing forces, see steer::ArchetypeTable::setWindow.
+        * \param window - an Uint32, zero groups every awake agent.
+        **/
+        void setArchetypeWindow(Uint32 window) { m_archetypes.setWindow(window); m_archetypesChanged = true; }
+
+        /**
+        * \fn const steer::ArchetypeTable& getArchetypes() const
+        * \brief Returns the awake agents bucketed by their active behaviors, as of the last step.
+        **/
+        const steer::ArchetypeTable& getArchetypes() const { return m_archetypes; }
+
+        /**
+        * \fn Uint64 getTick() const
+        * \brief Returns the number of steps taken, which keys the random streams of the agents along with their ids.
+        **/
+        Uint64 getTick() const { return m_tick; }
+
+        /**
+        * \fn void setTick(Uint64 tick)
+        * \brief Sets the step counter - restore it along with the agents to replay a simulation.
+        * \param tick - an Uint64.
+        **/
+        void setTick(Uint64 tick) { m_tick = tick; }
+
+        /**
+        * \fn void rebuildIndex()
+        * \brief Requests a full rebuild of the spatial index on the next step. Only needed after writing agent positions directly instead of through setPosition.
+        **/
+        void rebuildIndex() { m_rebuildIndex = true; }
+
+        /**
+        * \fn void rebuildObstacleIndex()
+        * \brief Requests a rebuild of the obstacle index on the next step. Only needed after moving or resizing an obstacle, adding and removing obstacles does this already.
+        **/
+        void rebuildObstacleIndex() { m_rebuildObstacles = true; }
+
+        /**
+        * \fn void rebuildWallIndex()
+        * \brief Requests a rebuild of the wall index on the next step. Only needed after moving a wall, adding and removing walls does this already.
+        **/
+        void rebuildWallIndex() { m_rebuildWalls = true; }
+
+        /**
+        * \fn std::vector<steer::SuperComponent*>& getAgents()
+        * \brief Returns the agents owned by the world.
+        **/
+        std::vector<steer::SuperComponent*>& getAgents() { return m_agents; }
+
+        /**
+        * \fn const std::vector<steer::SuperComponent*>& getAwakeAgents() const
+        * \brief Returns the agents step() updated last, the ones that are not asleep.
+        **/
+        const std::vector<steer::SuperComponent*>& getAwakeAgents() const { return m_awake; }
+
+        /**
+        * \fn std::vector<steer::SphereObstacle*>& getObstacles()
+        * \brief Returns the obstacles owned by the world.
+        **/
+        std::vector<steer::SphereObstacle*>& getObstacles() { return m_obstacles; }
+
+        /**
+        * \fn std::vector<steer::Wall*>& getWalls()
+        * \brief Returns the walls owned by the world.
+        **/
+        std::vector<steer::Wall*>& getWalls() { return m_walls; }
+
+        /**
+        * \fn std::vector<steer::Path*>& getPaths()
+        * \brief Returns the paths owned by the world.
+        **/
+        std::vector<steer::Path*>& getPaths() { return m_paths; }
+
+        /**
+        * \fn steer::SpatialHashGrid& getCellSpace()
+        * \brief Returns the spatial index every agent of the world is registered with.
+        **/
+        steer::SpatialHashGrid& getCellSpace() { return m_cellSpace; }
+
+        /**
+        * \fn const steer::ObstacleIndex& getObstacleIndex() const
+        * \brief Returns the index over the obstacles that agents of the world avoid and hide behind.
+        **/
+        const steer::ObstacleIndex& getObstacleIndex() const { return m_obstacleIndex; }
+
+        /**
+        * \fn const steer::WallIndex& getWallIndex() const
+        * \brief Returns the index over the walls that agents of the world avoid.
+        **/
+        const steer::WallIndex& getWallIndex() const { return m_wallIndex; }
+
+        /**
+        * \fn steer::BehaviorParameters* getParams()
+        * \brief Returns the parameters the world was constructed with.
+        **/
+        steer::BehaviorParameters* getParams() { return m_params; }
+
+    private:
+
+        //the world owns raw pointers handed out to agents, so it is not copyable
+        World(const World&);
+        World& operator=(const World&);
+
+        void parallelFor(Uint32 count, Uint32 grain, const std::function<void(Uint32, Uint32)>& job);
+
+        void refreshAwake();
+
+        void bindTargets();
+
+        void settle(float dt);
+
+        steer::BehaviorParameters*              m_params;///< pointer to the parameters shared by agents created by the world.
+        steer::SpatialHashGrid                  m_cellSpace;///< spatial index every agent is registered with.
+        std::vector<steer::SuperComponent*>     m_agents;///< agents owned by the world.
+        steer::AgentRegistry                    m_registry;///< handles of the agents, resolving them across moves.
+        std::vector<steer::SuperComponent*>     m_awake;///< agents that are not asleep, the ones step() updates.
+        std::vector<Uint32>                     m_agentIndex;///< position of each agent in m_agents, by the slot of its handle.
+        std::vector<Uint32>                     m_awakeIndex;///< position of each agent in m_awake by the slot of its handle, ~0 if it is not there.
+        std::vector<steer::SphereObstacle*>     m_obstacles;///< obstacles owned by the world.
+        steer::ObstacleIndex                    m_obstacleIndex;///< bounding volume hierarchy over the obstacles.
+        std::vector<steer::Wall*>               m_walls;///< walls owned by the world.
+        steer::WallIndex                        m_wallIndex;///< uniform grid over the walls.
+        std::vector<steer::Path*>               m_paths;///< paths owned by the world.
+        steer::ObjectPool<steer::SuperComponent> m_agentPool;///< slots of the agents created by the world.
+        steer::ObjectPool<steer::SphereObstacle> m_obstaclePool;///< slots of the obstacles created by the world.
+        steer::ObjectPool<steer::Wall>          m_wallPool;///< slots of the walls created by the world.
+        steer::ArchetypeTable                   m_archetypes;///< awake agents bucketed by their active behaviors, the order step() computes forces in.
+        steer::AgentStore                       m_store;///< structure of arrays the agents are integrated in.
+        steer::ThreadPool*                      m_pool;///< threads the force computation and integration are spread over, null when running on one thread.
+        steer::LodScheduler*                    m_lodScheduler;///< optional scheduler skipping the force computation of some agents, not owned.
+        Uint64                                  m_tick;///< number of steps taken.
+        bool                                    m_archetypesChanged;///< flag raised by agents changing behaviors or summing method, rebuilds m_archetypes on the next step.
+        bool                                    m_awakeChanged;///< flag raised by agents falling asleep or waking up, refreshes m_awake on the next step.
+        bool                                    m_bindTargets;///< flag raised by added agents, binds the targets of every agent on the next step.
+        bool                                    m_rebuildIndex;///< flag to rebuild the spatial index on the next step.
+        bool                                    m_rebuildObstacles;///< flag to rebuild the obstacle index on the next step.
+        bool                                    m_rebuildWalls;///< flag to rebuild the wall index on the next step.
+    };
+}
+
+#endif // WORLD_HPP
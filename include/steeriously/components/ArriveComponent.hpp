@@ -32,18 +32,6 @@ namespace steer
 			**/
 			float getWeight()const { return m_weightArrive; };
 
-			/**
-			* \fn void setRotation(float r);
-			* \brief Set the value of the Arrive component rotation.
-			**/
-			void setRotation(float r) { m_rotation = r; };
-
-			/**
-			* \fn float getRotation();
-			* \brief Get the value of the Arrive component rotation.
-			**/
-			float getRotation() { return m_rotation; };
-
             //pure virtual - must implement see Agent.hpp
             virtual bool on(steer::behaviorType behavior){return (m_iFlags & behavior) == behavior;};
 
@@ -62,7 +50,6 @@ namespace steer
         private:
 			float						m_weightArrive;///< Multiplier - can be adjusted to effect strength of the arrive behavior.
             Uint32                      m_iFlags;///<binary flags to indicate whether or not a behavior should be active.
-			float						m_rotation;///< rotation of the component for applying to drawables or other entities.
     };
 }
 
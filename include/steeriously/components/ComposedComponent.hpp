@@ -0,0 +1,115 @@
+#ifndef ComposedComponent_HPP
+#define ComposedComponent_HPP
+
+#include <vector>
+
+#include <steeriously/Agent.hpp>
+#include <steeriously/BehaviorData.hpp>
+#include <steeriously/BehaviorHelpers.hpp>
+#include <steeriously/Composition.hpp>
+#include <steeriously/ObstacleIndex.hpp>
+#include <steeriously/SphereObstacle.hpp>
+#include <steeriously/Vector2.hpp>
+#include <steeriously/Wall.hpp>
+#include <steeriously/WallIndex.hpp>
+
+namespace steer
+{
+    /**
+    *\class ComposedComponent
+    *\brief An agent steered by a steer::Steering composed from a list of behaviors, for agent archetypes known at compile time.
+    * <br />Derive your archetype from it, passing itself as Derived, e.g.
+    * class Boid : public steer::ComposedComponent<Boid, behaviors::Flocking, behaviors::WallAvoidance>. The behaviors are then
+    * called on a Boid*, so nothing in Calculate goes through a virtual call and the behaviors missing from the list cost nothing.
+    * Use steer::SteeringComponent when the archetype needs no members of its own.
+    * <br />The behaviors are set once and for all by the list - on() reports them, but they cannot be switched on and off. The
+    * weighted sum and prioritized summing methods are supported, prioritized evaluates the behaviors in the order of the list.
+    **/
+    template <class Derived, class... Behaviors>
+    class ComposedComponent : public steer::Agent
+    {
+    public:
+
+        typedef steer::Steering<Behaviors...> SteeringType;///< The steering composed from the behaviors.
+
+        ComposedComponent(steer::BehaviorParameters* params);
+        virtual ~ComposedComponent() {}
+
+        void setParams(steer::BehaviorParameters* params) { m_params = params; m_steering.setParams(*params); };
+        steer::BehaviorParameters* getParams() { return m_params; };
+
+        /**
+        * \fn template <class B> B& behavior()
+        * \brief Returns one of the behaviors of the agent, to set its weight or what it steers by - e.g. behavior<behaviors::Pursuit>().evader = prey.
+        **/
+        template <class B>
+        B& behavior() { return m_steering.template get<B>(); };
+
+        SteeringType& getSteering() { return m_steering; };
+
+        void setNeighbors(std::vector<steer::Agent*>* n) { m_neighbors = n; };
+        std::vector<steer::Agent*>* getNeighbors() { return m_neighbors; };
+
+        void setObstacles(std::vector<SphereObstacle*>* o) { m_obstacles = o; };
+        std::vector<SphereObstacle*>* getObstacles() { return m_obstacles; };
+
+        /**
+        * \fn void setObstacleIndex(const steer::ObstacleIndex* index)
+        * \brief Hands the agent an index over its obstacles, used in place of the obstacle list when set.
+        * \param index - a pointer to a steer::ObstacleIndex, null to go back to scanning the list.
+        **/
+        void setObstacleIndex(const steer::ObstacleIndex* index) { m_obstacleIndex = index; };
+        const steer::ObstacleIndex* getObstacleIndex() const { return m_obstacleIndex; };
+
+        void setWalls(std::vector<Wall*>* w) { m_walls = w; };
+        std::vector<Wall*>* getWalls() { return m_walls; };
+
+        /**
+        * \fn void setWallIndex(const steer::WallIndex* index)
+        * \brief Hands the agent an index over its walls, used in place of the wall list when set.
+        * \param index - a pointer to a steer::WallIndex, null to go back to scanning the list.
+        **/
+        void setWallIndex(const steer::WallIndex* index) { m_wallIndex = index; };
+        const steer::WallIndex* getWallIndex() const { return m_wallIndex; };
+
+        //pure virtual - must implement see Agent.hpp
+        virtual bool on(steer::behaviorType behavior) override { return (SteeringType::flags & behavior) == (Uint32)behavior; };
+
+        bool targetAcquired() { return getPosition() == getTarget(); };
+
+        /**
+        * \fn steer::Vector2 Calculate()
+        * \brief Gathers the neighbors when a behavior of the list looks at them, then sums the behaviors.
+        **/
+        virtual Vector2 Calculate() override final;
+
+        void Update(float dt);
+
+    protected:
+        SteeringType                                    m_steering;///< The behaviors of the agent.
+        std::vector<steer::Agent*>*                     m_neighbors;///< Neighboring flock members used when no cell space partition is set.
+        std::vector<SphereObstacle*>*                   m_obstacles;///< pointer to the obstacles needed to avoid them.
+        const steer::ObstacleIndex*                     m_obstacleIndex;///< optional index over the obstacles, queried instead of scanning them.
+        std::vector<Wall*>*                             m_walls;///< pointer to the walls needed to avoid them.
+        const steer::WallIndex*                         m_wallIndex;///< optional index over the walls, queried instead of scanning them.
+        steer::BehaviorParameters*                      m_params;///< pointer to the parameters.
+    };
+
+    /**
+    *\class SteeringComponent
+    *\brief A steer::ComposedComponent with nothing of its own, e.g. steer::SteeringComponent<behaviors::Seek, behaviors::ObstacleAvoidance>.
+    **/
+    template <class... Behaviors>
+    class SteeringComponent final : public steer::ComposedComponent<SteeringComponent<Behaviors...>, Behaviors...>
+    {
+    public:
+        SteeringComponent(steer::BehaviorParameters* params)
+        : steer::ComposedComponent<SteeringComponent<Behaviors...>, Behaviors...>(params)
+        {
+        }
+    };
+}
+
+#include <steeriously/components/ComposedComponent.inl>
+
+#endif // ComposedComponent_HPP
@@ -0,0 +1,61 @@
+#include <cmath>
+
+#include <steeriously/Profiler.hpp>
+
+template <class Derived, class... Behaviors>
+steer::ComposedComponent<Derived, Behaviors...>::ComposedComponent(steer::BehaviorParameters* params)
+: Agent(params)
+, m_steering()
+, m_neighbors(nullptr)
+, m_obstacles(nullptr)
+, m_obstacleIndex(nullptr)
+, m_walls(nullptr)
+, m_wallIndex(nullptr)
+, m_params(params)
+{
+    m_steering.setParams(*params);
+
+    //stuff for the wander behavior
+    float theta = m_random.nextFloat() * TwoPi;
+
+    //create a vector to a target position on the wander circle
+    m_wanderTarget = steer::Vector2(m_wanderRadius * cos(theta), m_wanderRadius * sin(theta));
+}
+
+template <class Derived, class... Behaviors>
+steer::Vector2 steer::ComposedComponent<Derived, Behaviors...>::Calculate()
+{
+    STEERIOUSLY_PROFILE_SCOPE(steer::profile::calculate);
+
+    Derived* self = static_cast<Derived*>(this);
+
+    //known at compile time, archetypes without flocking never get here
+    if (SteeringType::needsNeighbors)
+    {
+        if (m_cellSpace != nullptr)
+            GatherVehiclesWithinViewRange(self, *m_cellSpace, m_viewDistance, m_neighborhood);
+        else
+            GatherVehiclesWithinViewRange(self, *m_neighbors, m_viewDistance, m_neighborhood);
+    }
+
+    if (m_summingMethod == steer::summingMethod::prioritized)
+        m_steeringForce = m_steering.prioritized(self);
+    else
+        m_steeringForce = m_steering.weightedSum(self);
+
+    return m_steeringForce;
+}
+
+template <class Derived, class... Behaviors>
+void steer::ComposedComponent<Derived, Behaviors...>::Update(float dt)
+{
+    //update the time elapsed
+    m_timeElapsed = dt;
+
+    //calculate the combined force from each steering behavior in the
+    //vehicle's list
+    Calculate();
+
+    //move the agent according to the force
+    integrate(dt);
+}
@@ -2,8 +2,11 @@
 #define FlockingComponent_HPP
 
 #include <steeriously/Agent.hpp>
+#include <steeriously/FlockingKernel.hpp>
+#include <steeriously/ObstacleIndex.hpp>
 #include <steeriously/SphereObstacle.hpp>
 #include <steeriously/Wall.hpp>
+#include <steeriously/WallIndex.hpp>
 
 namespace steer
 {
@@ -24,21 +27,31 @@ namespace steer
 
 		void Update(float dt);
 
-		/**
-		* \fn float getRotation();
-		* \brief Get the value of the seek component rotation.
-		**/
-		float getRotation() { return m_rotation; };
-
 		void setNeighbors(std::vector<FlockingComponent*>* n) { m_neighbors = n; };
 		std::vector<FlockingComponent*>* getNeighbors() { return m_neighbors; };
 
 		void setObstacles(std::vector<SphereObstacle*>* o) { m_obstacles = o; };
 		std::vector<SphereObstacle*>* getObstacles() { return m_obstacles; };
 
+		/**
+		* \fn void setObstacleIndex(const steer::ObstacleIndex* index)
+		* \brief Hands the agent an index over its obstacles, used in place of the obstacle list when set.
+		* \param index - a pointer to a steer::ObstacleIndex, null to go back to scanning the list.
+		**/
+		void setObstacleIndex(const steer::ObstacleIndex* index) { m_obstacleIndex = index; };
+		const steer::ObstacleIndex* getObstacleIndex() const { return m_obstacleIndex; };
+
 		void setWalls(std::vector<Wall*>* w) { m_walls = w; };
 		std::vector<Wall*>* getWalls() { return m_walls; };
 
+		/**
+		* \fn void setWallIndex(const steer::WallIndex* index)
+		* \brief Hands the agent an index over its walls, used in place of the wall list when set.
+		* \param index - a pointer to a steer::WallIndex, null to go back to scanning the list.
+		**/
+		void setWallIndex(const steer::WallIndex* index) { m_wallIndex = index; };
+		const steer::WallIndex* getWallIndex() const { return m_wallIndex; };
+
 		//pure virtual - must implement see Agent.hpp
 		virtual bool on(steer::behaviorType behavior) override { return (m_iFlags & behavior) == behavior; };
 
@@ -97,7 +110,34 @@ namespace steer
 		//optional virtual
 		virtual Vector2 calculateWeightedSum() override;
 
+		/**
+		* \fn steer::Vector2 calculatePrioritized()
+		* \brief Accumulates the active behaviors in order of priority - wall avoidance, obstacle avoidance, separation, alignment, cohesion, seek, wander - until the max force is used up.
+		* <br />Used when the summing method is steer::summingMethod::prioritized. Neighbors are only gathered when the flocking behaviors get their turn.
+		**/
+		virtual Vector2 calculatePrioritized() override;
+
+		/**
+		* \fn steer::Vector2 calculateDithered()
+		* \brief Evaluates each active behavior with the probability set in the parameters (prWallAvoidance, prSeparation, ...) and returns the first non zero force, scaled by the inverse of its probability.
+		* <br />Used when the summing method is steer::summingMethod::dithered. Neighbors are only gathered on ticks a flocking behavior is picked.
+		**/
+		virtual Vector2 calculateDithered() override;
+
+		/**
+		* \fn void tagNeighbors()
+		* \brief Gathers the neighbors the flocking behaviors are going to look at, see steer::SuperComponent::tagNeighbors.
+		**/
+		void tagNeighbors();
+
 	private:
+		steer::FlockingForces flockingForces();
+		steer::Vector2 separationForce();
+		steer::Vector2 alignmentForce();
+		steer::Vector2 cohesionForce();
+		steer::Vector2 obstacleAvoidanceForce();
+		steer::Vector2 wallAvoidanceForce();
+
 		float											m_weightSeek;///< Multiplier - can be adjusted to effect strength of the seeking behavior.
 		float                                           m_weightWander;///< Multiplier - can be adjusted to effect strength of the wander behavior.
 		float											m_weightAlignment;///< Multiplier - can be adjusted to effect strength of the alignment behavior.
@@ -106,10 +146,11 @@ namespace steer
 		float											m_weightObstacleAvoidance;///< Multiplier - can be adjusted to effect strength of the obstacle avoidance behavior.
 		float                                           m_weightWallAvoidance;///< Multiplier - can be adjusted to effect strength of the wall avoidance behavior.
 		Uint32										    m_iFlags;///< binary flags to indicate whether or not a behavior should be active
-		float											m_rotation;///< rotation of the component for applying to drawables and other entities.
 		std::vector<FlockingComponent*>*                m_neighbors;///< Neighboring flock members used for calculating alignment/separation/cohesion forces.
 		std::vector<SphereObstacle*>*					m_obstacles;///< pointer to the obstacles needed to avoid them.
+		const steer::ObstacleIndex*                     m_obstacleIndex;///< optional index over the obstacles, queried instead of scanning them.
 		std::vector<Wall*>*					            m_walls;///< pointer to the walls needed to avoid them.
+		const steer::WallIndex*                         m_wallIndex;///< optional index over the walls, queried instead of scanning them.
 		steer::BehaviorParameters*						m_params;///< pointer to flock parameters.
 	};
 }
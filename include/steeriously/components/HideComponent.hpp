@@ -4,6 +4,7 @@
 #include <steeriously/Agent.hpp>
 #include <steeriously/BehaviorData.hpp>
 #include <steeriously/BehaviorHelpers.hpp>
+#include <steeriously/ObstacleIndex.hpp>
 #include <steeriously/Vector2.hpp>
 
 namespace steer
@@ -34,22 +35,17 @@ namespace steer
 			**/
 			float getWeight()const { return m_weightHide; };
 
-			/**
-			* \fn void setRotation(float r);
-			* \brief Set the value of the Hide component rotation.
-			**/
-			void setRotation(float r) { m_rotation = r; };
-
-			/**
-			* \fn float getRotation();
-			* \brief Get the value of the
-			Hide component rotation.
-			**/
-			float getRotation() { return m_rotation; };
-
 			void setObstacles(std::vector<SphereObstacle*>* o) { m_obstacles = o; };
             std::vector<SphereObstacle*>* getObstacles() { return m_obstacles; };
 
+            /**
+            * \fn void setObstacleIndex(const steer::ObstacleIndex* index)
+            * \brief Hands the agent an index over its obstacles, used in place of the obstacle list when set.
+            * \param index - a pointer to a steer::ObstacleIndex, null to go back to scanning the list.
+            **/
+            void setObstacleIndex(const steer::ObstacleIndex* index) { m_obstacleIndex = index; };
+            const steer::ObstacleIndex* getObstacleIndex() const { return m_obstacleIndex; };
+
             //pure virtual - must implement see Agent.hpp
             virtual bool on(steer::behaviorType behavior){return (m_iFlags & behavior) == behavior;};
 
@@ -69,9 +65,9 @@ namespace steer
         private:
 			float						                    m_weightHide;///< Multiplier - can be adjusted to effect strength of the Hiding behavior.
             Uint32                                          m_iFlags;///< binary flags to indicate whether or not a behavior should be active
-			float						                    m_rotation;///< rotation of the component for applying to drawables or other entities.
             steer::Agent*                                   m_targetAgent;///< The target agent that your entity will be avoiding.
             std::vector<SphereObstacle*>*					m_obstacles;///< pointer to the obstacles needed to avoid them.
+            const steer::ObstacleIndex*                     m_obstacleIndex;///< optional index over the obstacles, queried instead of scanning them.
             steer::BehaviorParameters*						m_params;///< pointer to flock parameters.
     };
 }
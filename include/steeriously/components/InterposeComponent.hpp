@@ -31,18 +31,6 @@ namespace steer
 			**/
 			float getWeight()const { return m_weightInterpose; };
 
-			/**
-			* \fn void setRotation(float r);
-			* \brief Set the value of the Interpose component rotation.
-			**/
-			void setRotation(float r) { m_rotation = r; };
-
-			/**
-			* \fn float getRotation();
-			* \brief Get the value of the Interpose component rotation.
-			**/
-			float getRotation() { return m_rotation; };
-
             //pure virtual - must implement see Agent.hpp
             virtual bool on(steer::behaviorType behavior){return (m_iFlags & behavior) == behavior;};
 
@@ -66,7 +54,6 @@ namespace steer
         private:
 			float						m_weightInterpose;///< Multiplier - can be adjusted to effect strength of the Interposeing behavior.
             Uint32                      m_iFlags;///<binary flags to indicate whether or not a behavior should be active
-			float						m_rotation;///< rotation of the component for applying to drawables or other entities.
 			steer::Agent*               m_agentA;///< pointer to first agent the Interposing agent will get between.
 			steer::Agent*               m_agentB;///< pointer to second agent the Interposing agent will get between.
 			steer::BehaviorParameters*	m_params;///< pointer to parameters.
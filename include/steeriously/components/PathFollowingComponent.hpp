@@ -33,20 +33,16 @@ namespace steer
 			**/
 			float getWeight()const { return m_weightPathFollowing; };
 
-			/**
-			* \fn void setRotation(float r);
-			* \brief Set the value of the Path Following component rotation.
-			**/
-			void setRotation(float r) { m_rotation = r; };
+			void setPath(steer::Path* p){m_path = p;};
+			steer::Path* getPath() const {return m_path;};
 
 			/**
-			* \fn float getRotation();
-			* \brief Get the value of the Path Following component rotation.
+			* \fn void setPathData(const steer::PathData* data)
+			* \brief Follows a path shared with other agents with a cursor of the agent's own, used when no steer::Path is set.
+			* \param data - a pointer to a steer::PathData, null to stop following it.
 			**/
-			float getRotation() { return m_rotation; };
-
-			void setPath(steer::Path* p){m_path = p;};
-			steer::Path* getPath() const {return m_path;};
+			void setPathData(const steer::PathData* data) { m_pathCursor.set(data); };
+			steer::PathCursor& getPathCursor() { return m_pathCursor; };
 
             //pure virtual - must implement see Agent.hpp
             virtual bool on(steer::behaviorType behavior){return (m_iFlags & behavior) == behavior;};
@@ -66,8 +62,8 @@ namespace steer
         private:
 			float						m_weightPathFollowing;///< Multiplier - can be adjusted to effect strength of the Path Following behavior.
             Uint32                      m_iFlags;///<binary flags to indicate whether or not a behavior should be active
-			float						m_rotation;///< rotation of the component for applying to drawables or other entities.
             steer::Path*                m_path;///< pointer to path that the Agent will follow.
+            steer::PathCursor           m_pathCursor;///< the agent's own progress along a shared path, used when m_path is null.
             steer::BehaviorParameters*	m_params;///< pointer to flock parameters.
     };
 }
@@ -2,6 +2,7 @@
 #define SuperComponent_HPP
 
 #include <steeriously/libinc.hpp>
+#include <steeriously/FlockingKernel.hpp>
 
 namespace steer
 {
@@ -20,58 +21,121 @@ namespace steer
 
 		void Update(float dt);
 
-		/**
-		* \fn float getRotation();
-		* \brief Get the value of the seek component rotation.
-		**/
-		float getRotation() { return m_rotation; };
-
 		void setNeighbors(std::vector<SuperComponent*>* n) { m_neighbors = n; };
 		std::vector<SuperComponent*>* getNeighbors() { return m_neighbors; };
 
 		void setObstacles(std::vector<SphereObstacle*>* o) { m_obstacles = o; };
 		std::vector<SphereObstacle*>* getObstacles() { return m_obstacles; };
 
+		/**
+		* \fn void setObstacleIndex(const steer::ObstacleIndex* index)
+		* \brief Hands the agent an index over its obstacles, used in place of the obstacle list when set.
+		* \param index - a pointer to a steer::ObstacleIndex, null to go back to scanning the list.
+		**/
+		void setObstacleIndex(const steer::ObstacleIndex* index) { m_obstacleIndex = index; };
+		const steer::ObstacleIndex* getObstacleIndex() const { return m_obstacleIndex; };
+
 		void setWalls(std::vector<Wall*>* w) { m_walls = w; };
 		std::vector<Wall*>* getWalls() { return m_walls; };
 
+		/**
+		* \fn void setWallIndex(const steer::WallIndex* index)
+		* \brief Hands the agent an index over its walls, used in place of the wall list when set.
+		* \param index - a pointer to a steer::WallIndex, null to go back to scanning the list.
+		**/
+		void setWallIndex(const steer::WallIndex* index) { m_wallIndex = index; };
+		const steer::WallIndex* getWallIndex() const { return m_wallIndex; };
+
 		void setPath(steer::Path* p){m_path = p;};
         steer::Path* getPath() const {return m_path;};
 
+		/**
+		* \fn void setPathData(const steer::PathData* data)
+		* \brief Follows a path shared with other agents with a cursor of the agent's own, used when no steer::Path is set.
+		* \param data - a pointer to a steer::PathData, null to stop following it.
+		**/
+		void setPathData(const steer::PathData* data) { m_pathCursor.set(data); };
+		steer::PathCursor& getPathCursor() { return m_pathCursor; };
+
+		/**
+		* \fn Uint32 getFlags() const
+		* \brief Returns the steer::behaviorType bits of the active behaviors.
+		**/
+		Uint32 getFlags() const { return m_iFlags; };
+
+		/**
+		* \fn void setFlags(Uint32 flags)
+		* \brief Sets the steer::behaviorType bits of the active behaviors all at once, the xxxOn/xxxOff methods go through it.
+		* \param flags - an Uint32.
+		**/
+		void setFlags(Uint32 flags)
+		{
+			if (flags == m_iFlags)
+				return;
+
+			m_iFlags = flags;
+
+			//the weighted sum runs the same steps as steer::ArchetypeTable
+			steer::ArchetypeTable::buildSteps(flags, m_steps);
+
+			if (m_archetypeFlag != nullptr)
+				*m_archetypeFlag = true;
+		};
+
+		/**
+		* \fn void setArchetypeFlag(bool* flag)
+		* \brief Sets a flag raised whenever the active behaviors or the summing method change, steer::World uses it to rebuild its steer::ArchetypeTable.
+		* \param flag - a pointer to a bool, or null.
+		**/
+		void setArchetypeFlag(bool* flag) { m_archetypeFlag = flag; };
+
+		/**
+		* \fn void setSummingMethod(Uint32 sumMethod)
+		* \brief Sets the summing method and raises the archetype flag when it changes.
+		* \param sumMethod - an Uint32, see steer::summingMethod.
+		**/
+		virtual void setSummingMethod(Uint32 sumMethod) override
+		{
+			if (sumMethod != m_summingMethod && m_archetypeFlag != nullptr)
+				*m_archetypeFlag = true;
+
+			Agent::setSummingMethod(sumMethod);
+		};
+
 		//pure virtual - must implement see Agent.hpp
 		virtual bool on(steer::behaviorType behavior) override { return (m_iFlags & behavior) == behavior; };
 
-		void alignmentOn() { m_iFlags |= steer::behaviorType::alignment; };
-		void separationOn() { m_iFlags |= steer::behaviorType::separation; };
-		void cohesionOn() { m_iFlags |= steer::behaviorType::cohesion; };
-		void seekOn() { m_iFlags |= steer::behaviorType::seek; };
-		void wanderOn() { m_iFlags |= steer::behaviorType::wander; };
-		void wallAvoidanceOn() { m_iFlags |= steer::behaviorType::wallAvoidance; };
-		void obstacleAvoidanceOn() { m_iFlags |= steer::behaviorType::obstacleAvoidance; };
-        void pursuitOn(){m_iFlags |= steer::behaviorType::pursuit;};
-        void offsetPursuitOn(){m_iFlags |= steer::behaviorType::offsetPursuit;};
-        void interposeOn(){m_iFlags |= steer::behaviorType::interpose;};
-        void hideOn(){m_iFlags |= steer::behaviorType::hide;};
-        void pathFollowingOn(){m_iFlags |= steer::behaviorType::followPath;};
-        void fleeOn(){m_iFlags |= steer::behaviorType::flee;};
-        void evadeOn(){m_iFlags |= steer::behaviorType::evade;};
-        void arriveOn(){m_iFlags |= steer::behaviorType::arrive;};
-
-		void cohesionOff() { if (on(steer::behaviorType::cohesion)) m_iFlags ^= steer::behaviorType::cohesion; };
-		void separationOff() { if (on(steer::behaviorType::separation)) m_iFlags ^= steer::behaviorType::separation; };
-		void alignmentOff() { if (on(steer::behaviorType::alignment)) m_iFlags ^= steer::behaviorType::alignment; };
-		void seekOff() { if (on(steer::behaviorType::seek)) m_iFlags ^= steer::behaviorType::seek; };
-		void wanderOff() { if (on(steer::behaviorType::wander)) m_iFlags ^= steer::behaviorType::wander; };
-		void wallAvoidanceOff() { if (on(steer::behaviorType::wallAvoidance)) m_iFlags ^= steer::behaviorType::wallAvoidance; };
-		void obstacleAvoidanceOff() { if (on(steer::behaviorType::obstacleAvoidance)) m_iFlags ^= steer::behaviorType::obstacleAvoidance; };
-        void pursuitOff(){if(on(steer::behaviorType::pursuit))   m_iFlags ^=steer::behaviorType::pursuit;};
-        void offsetPursuitOff(){if(on(steer::behaviorType::offsetPursuit))   m_iFlags ^=steer::behaviorType::offsetPursuit;}
-        void interposeOff(){if(on(steer::behaviorType::interpose))   m_iFlags ^=steer::behaviorType::interpose;}
-        void hideOff(){if(on(steer::behaviorType::hide))   m_iFlags ^=steer::behaviorType::hide;}
-        void pathFollowingOff(){if(on(steer::behaviorType::followPath))   m_iFlags ^=steer::behaviorType::followPath;}
-        void fleeOff(){if(on(steer::behaviorType::flee))   m_iFlags ^=steer::behaviorType::flee;}
-        void evadeOff(){if(on(steer::behaviorType::evade))   m_iFlags ^=steer::behaviorType::evade;}
-        void arriveOff(){if(on(steer::behaviorType::arrive))   m_iFlags ^=steer::behaviorType::arrive;}
+		void alignmentOn() { setFlags(m_iFlags | steer::behaviorType::alignment); };
+		void separationOn() { setFlags(m_iFlags | steer::behaviorType::separation); };
+		void cohesionOn() { setFlags(m_iFlags | steer::behaviorType::cohesion); };
+		void seekOn() { setFlags(m_iFlags | steer::behaviorType::seek); };
+		void wanderOn() { setFlags(m_iFlags | steer::behaviorType::wander); };
+		void wallAvoidanceOn() { setFlags(m_iFlags | steer::behaviorType::wallAvoidance); };
+		void obstacleAvoidanceOn() { setFlags(m_iFlags | steer::behaviorType::obstacleAvoidance); };
+        void pursuitOn(){setFlags(m_iFlags | steer::behaviorType::pursuit);};
+        void offsetPursuitOn(){setFlags(m_iFlags | steer::behaviorType::offsetPursuit);};
+        void interposeOn(){setFlags(m_iFlags | steer::behaviorType::interpose);};
+        void hideOn(){setFlags(m_iFlags | steer::behaviorType::hide);};
+        void pathFollowingOn(){setFlags(m_iFlags | steer::behaviorType::followPath);};
+        void fleeOn(){setFlags(m_iFlags | steer::behaviorType::flee);};
+        void evadeOn(){setFlags(m_iFlags | steer::behaviorType::evade);};
+        void arriveOn(){setFlags(m_iFlags | steer::behaviorType::arrive);};
+
+		void cohesionOff() { setFlags(m_iFlags & ~steer::behaviorType::cohesion); };
+		void separationOff() { setFlags(m_iFlags & ~steer::behaviorType::separation); };
+		void alignmentOff() { setFlags(m_iFlags & ~steer::behaviorType::alignment); };
+		void seekOff() { setFlags(m_iFlags & ~steer::behaviorType::seek); };
+		void wanderOff() { setFlags(m_iFlags & ~steer::behaviorType::wander); };
+		void wallAvoidanceOff() { setFlags(m_iFlags & ~steer::behaviorType::wallAvoidance); };
+		void obstacleAvoidanceOff() { setFlags(m_iFlags & ~steer::behaviorType::obstacleAvoidance); };
+        void pursuitOff(){setFlags(m_iFlags & ~steer::behaviorType::pursuit);};
+        void offsetPursuitOff(){setFlags(m_iFlags & ~steer::behaviorType::offsetPursuit);}
+        void interposeOff(){setFlags(m_iFlags & ~steer::behaviorType::interpose);}
+        void hideOff(){setFlags(m_iFlags & ~steer::behaviorType::hide);}
+        void pathFollowingOff(){setFlags(m_iFlags & ~steer::behaviorType::followPath);}
+        void fleeOff(){setFlags(m_iFlags & ~steer::behaviorType::flee);}
+        void evadeOff(){setFlags(m_iFlags & ~steer::behaviorType::evade);}
+        void arriveOff(){setFlags(m_iFlags & ~steer::behaviorType::arrive);}
 
 		bool isCohesionOn() { return on(steer::behaviorType::cohesion); };
 		bool isSeparationOn() { return on(steer::behaviorType::separation); };
@@ -114,31 +178,78 @@ namespace steer
 
 		bool targetAcquired();
 
-		void setEvadeAgent(steer::Agent* a){m_evadeAgent = a;};
-        steer::Agent* getEvadeAgent() const {return m_evadeAgent;};
+		//targets are held by steer::AgentRef, pass a pointer or a reference
+		//made from a handle (see World::getRef) - the getters resolve them,
+		//null once the target was removed
+		void setEvadeAgent(steer::AgentRef a){m_evadeAgent = a;};
+        steer::Agent* getEvadeAgent() const {return resolve(m_evadeAgent);};
 
-		void setPursuitAgent(steer::Agent* a){m_pursuitAgent = a;};
-        steer::Agent* getPursuitAgent() const {return m_pursuitAgent;};
+		void setPursuitAgent(steer::AgentRef a){m_pursuitAgent = a;};
+        steer::Agent* getPursuitAgent() const {return resolve(m_pursuitAgent);};
 
-        void setLeader(steer::Agent* l){m_leader = l;};
-        steer::Agent* getLeader() const {return m_leader;};
+        void setLeader(steer::AgentRef l){m_leader = l;};
+        steer::Agent* getLeader() const {return resolve(m_leader);};
 
-        void setInterposeAgents(steer::Agent* a, steer::Agent* b){m_interposeAgentA = a; m_interposeAgentB = b;};
-        void setInterposeAgentA(steer::Agent* a){m_interposeAgentA = a;};
-        void setInterposeAgentB(steer::Agent* b){m_interposeAgentB = b;};
+        void setInterposeAgents(steer::AgentRef a, steer::AgentRef b){m_interposeAgentA = a; m_interposeAgentB = b;};
+        void setInterposeAgentA(steer::AgentRef a){m_interposeAgentA = a;};
+        void setInterposeAgentB(steer::AgentRef b){m_interposeAgentB = b;};
 
-        steer::Agent* getInterposeAgentA() const {return m_interposeAgentA;};
-        steer::Agent* getInterposeAgentB() const {return m_interposeAgentB;};
+        steer::Agent* getInterposeAgentA() const {return resolve(m_interposeAgentA);};
+        steer::Agent* getInterposeAgentB() const {return resolve(m_interposeAgentB);};
 
-        void setHideAgent(steer::Agent* a){m_hideAgent = a;};
-        steer::Agent* getHideAgent() const {return m_hideAgent;};
+        void setHideAgent(steer::AgentRef a){m_hideAgent = a;};
+        steer::Agent* getHideAgent() const {return resolve(m_hideAgent);};
+
+		/**
+		* \fn void bindTargets()
+		* \brief Swaps targets held by pointer for the handles the targets have been given since, so they follow the targets when they move.
+		* <br />steer::World calls it before moving its agents, see World::defragment.
+		**/
+		void bindTargets();
+
+		/**
+		* \fn bool hasMovingTarget() const
+		* \brief Returns true if an agent one of the active behaviors steers by (evade, pursuit, offset pursuit, interpose, hide) is awake and moving faster than its sleep speed.
+		* <br />steer::World wakes sleepers whose target moves, so a follower is not left behind by its leader.
+		**/
+		bool hasMovingTarget() const;
 
 		//pure virtual - must implement see Agent.hpp
 		virtual Vector2 Calculate() override;
 
+		/**
+		* \fn void tagNeighbors()
+		* \brief First half of Calculate - gathers the neighbors the flocking behaviors are going to look at.
+		* <br />The neighbors are collected into m_neighborhood from the cell space partition, or in a scan over every agent
+		* without one. Gathers when any of separation, alignment or cohesion is on, and empties m_neighborhood otherwise.
+		* <br />No other agent is written to, so many agents can gather at once.
+		**/
+		void tagNeighbors();
+
+		/**
+		* \fn steer::Vector2 calculateForce()
+		* \brief Second half of Calculate - computes the steering force from the neighbors gathered by the last call to tagNeighbors, summed as set by setSummingMethod.
+		* <br />Only writes to the agent itself, so it can run for many agents at once.
+		**/
+		steer::Vector2 calculateForce();
+
 		//optional virtual
 		virtual Vector2 calculateWeightedSum() override;
 
+		/**
+		* \fn steer::Vector2 calculatePrioritized()
+		* \brief Accumulates the active behaviors in order of priority - wall avoidance, obstacle avoidance, evade, flee, separation, alignment, cohesion, seek, arrive, wander, pursuit, offset pursuit, interpose, hide, path following - until the max force is used up.
+		* <br />Behaviors left once the max force is used up are skipped entirely, neighbors are only gathered when the flocking behaviors get their turn.
+		**/
+		virtual Vector2 calculatePrioritized() override;
+
+		/**
+		* \fn steer::Vector2 calculateDithered()
+		* \brief Evaluates each active behavior with the probability set in the parameters (prWallAvoidance, prSeparation, ...) and returns the first non zero force, scaled by the inverse of its probability.
+		* <br />Most behaviors are skipped on most ticks, the expected number evaluated per tick is the sum of the probabilities of the active behaviors.
+		**/
+		virtual Vector2 calculateDithered() override;
+
 	public:
 		float											m_weightSeek;///< Multiplier - can be adjusted to effect strength of the seeking behavior.
 		float											m_weightFlee;///< Multiplier - can be adjusted to effect strength of the fleeing behavior.
@@ -155,19 +266,35 @@ namespace steer
 		float											m_weightObstacleAvoidance;///< Multiplier - can be adjusted to effect strength of the obstacle avoidance behavior.
 		float                                           m_weightWallAvoidance;///< Multiplier - can be adjusted to effect strength of the wall avoidance behavior.
 		float						                    m_weightPathFollowing;///< Multiplier - can be adjusted to effect strength of the Path Following behavior.
+
+		//unweighted forces of the behaviors reading the neighbors, obstacles, walls
+		//or path of the agent - steer::ArchetypeTable builds its kernels from them
+		steer::FlockingForces flockingForces();
+		steer::Vector2 separationForce();
+		steer::Vector2 alignmentForce();
+		steer::Vector2 cohesionForce();
+		steer::Vector2 obstacleAvoidanceForce();
+		steer::Vector2 wallAvoidanceForce();
+		steer::Vector2 hideForce();
+		steer::Vector2 pathFollowingForce();
+
     private:
 		Uint32										    m_iFlags;///< binary flags to indicate whether or not a behavior should be active
-		float											m_rotation;///< rotation of the component for applying to drawables and other entities.
-		steer::Agent*                                   m_evadeAgent;///< The target agent that your entity will be evading.
-		steer::Agent*                                   m_pursuitAgent;///< The target agent that your entity will be pursuing.
-		steer::Agent*                                   m_leader;///< pointer to agent that is leading the pursuit.
-		steer::Agent*                                   m_interposeAgentA;///< pointer to first agent the Interposing agent will get between.
-		steer::Agent*                                   m_interposeAgentB;///< pointer to second agent the Interposing agent will get between.
-		steer::Agent*                                   m_hideAgent;///< The target agent that your entity will be avoiding.
+		bool*                                           m_archetypeFlag;///< optional flag raised when m_iFlags or the summing method change.
+		std::vector<steer::ArchetypeStep>               m_steps;///< the behaviors of m_iFlags the weighted sum runs, see steer::ArchetypeTable::buildSteps.
+		steer::AgentRef                                 m_evadeAgent;///< The target agent that your entity will be evading.
+		steer::AgentRef                                 m_pursuitAgent;///< The target agent that your entity will be pursuing.
+		steer::AgentRef                                 m_leader;///< reference to agent that is leading the pursuit.
+		steer::AgentRef                                 m_interposeAgentA;///< reference to first agent the Interposing agent will get between.
+		steer::AgentRef                                 m_interposeAgentB;///< reference to second agent the Interposing agent will get between.
+		steer::AgentRef                                 m_hideAgent;///< The target agent that your entity will be avoiding.
 		std::vector<SuperComponent*>*                   m_neighbors;///< Neighboring flock members used for calculating alignment/separation/cohesion forces.
 		std::vector<SphereObstacle*>*					m_obstacles;///< pointer to the obstacles needed to avoid them.
+		const steer::ObstacleIndex*                     m_obstacleIndex;///< optional index over the obstacles, queried instead of scanning them.
 		std::vector<Wall*>*					            m_walls;///< pointer to the walls needed to avoid them.
+		const steer::WallIndex*                         m_wallIndex;///< optional index over the walls, queried instead of scanning them.
 		steer::Path*                                    m_path;///< pointer to path that the Agent will follow.
+		steer::PathCursor                               m_pathCursor;///< the agent's own progress along a shared path, used when m_path is null.
 		steer::BehaviorParameters*						m_params;///< pointer to flock parameters.
 	};
 }
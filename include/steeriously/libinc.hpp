@@ -2,28 +2,43 @@
 #define LIBINC_HPP
 
 #include <steeriously/Agent.hpp>
+#include <steeriously/AgentRegistry.hpp>
+#include <steeriously/AgentStore.hpp>
+#include <steeriously/ArchetypeTable.hpp>
 #include <steeriously/components/ArriveComponent.hpp>
 #include <steeriously/BehaviorData.hpp>
 #include <steeriously/BehaviorHelpers.hpp>
+#include <steeriously/components/ComposedComponent.hpp>
+#include <steeriously/Composition.hpp>
 #include <steeriously/components/EvadeComponent.hpp>
+#include <steeriously/FixedTimestep.hpp>
 #include <steeriously/components/FleeComponent.hpp>
 #include <steeriously/components/FlockingComponent.hpp>
+#include <steeriously/FlockingKernel.hpp>
 #include <steeriously/GeometryHelpers.hpp>
 #include <steeriously/components/HideComponent.hpp>
 #include <steeriously/components/InterposeComponent.hpp>
+#include <steeriously/LodScheduler.hpp>
 #include <steeriously/Matrix.hpp>
+#include <steeriously/ObjectPool.hpp>
+#include <steeriously/ObstacleIndex.hpp>
 #include <steeriously/components/OffsetPursuitComponent.hpp>
 #include <steeriously/Path.hpp>
+#include <steeriously/Profiler.hpp>
 #include <steeriously/components/PathFollowingComponent.hpp>
 #include <steeriously/components/PursuitComponent.hpp>
 #include <steeriously/components/SeekComponent.hpp>
+#include <steeriously/SpatialHashGrid.hpp>
 #include <steeriously/SphereObstacle.hpp>
 #include <steeriously/components/SuperComponent.hpp>
+#include <steeriously/ThreadPool.hpp>
 #include <steeriously/Transformations.hpp>
 #include <steeriously/Utilities.hpp>
 #include <steeriously/Vector2.hpp>
 #include <steeriously/VectorMath.hpp>
 #include <steeriously/Wall.hpp>
+#include <steeriously/WallIndex.hpp>
 #include <steeriously/components/WanderComponent.hpp>
+#include <steeriously/World.hpp>
 
 #endif // LIBINC_HPP
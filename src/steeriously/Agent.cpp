@@ -1,18 +1,34 @@
 #include <assert.h>
+#include <atomic>
 
 #include <steeriously/Agent.hpp>
 #include <steeriously/BehaviorData.hpp>
+#include <steeriously/Profiler.hpp>
 #include <steeriously/Transformations.hpp>
 
 using namespace steer;
 
+namespace
+{
+    //hands out agent ids, agents created on several threads still get distinct ones
+    Uint32 nextId()
+    {
+        static std::atomic<Uint32> counter(0);
+
+        return counter++;
+    }
+}
+
 steer::Agent::Agent()
 	: m_scale(Vector2(1.f, 1.f))
+	, m_rotation(0.f)
 	, m_boundingRadius(0.f)
 	, m_tag(false)
 	, m_steeringForce(Vector2(0.0, 0.0))
 	, m_waypointSeekDistanceSquared(0.f)
-	, m_feelers(3)
+	, m_feelers()
+	, m_cellSpace(nullptr)
+	, m_doubleBuffered(false)
 	, m_velocity(Vector2(0.0, 0.0))
 	, m_heading(Vector2(0.0, 0.0))
 	, m_side(Vector2(0.0, 0.0))
@@ -26,6 +42,7 @@ steer::Agent::Agent()
 	, m_maxSpeed(100.f)
 	, m_maxForce(400.f)
 	, m_maxTurnRate(10.f)
+	, m_summingMethod(steer::summingMethod::weightedSum)
 	, m_target(Vector2(0.0, 0.0))
 	, m_threatRange(0.f)
 	, m_decelerationTweaker(1.f)
@@ -34,17 +51,31 @@ steer::Agent::Agent()
 	, m_wanderJitter(0.f)
 	, m_wanderRadius(0.f)
 	, m_wanderDistance(0.f)
+	, m_externalForce(Vector2(0.0, 0.0))
+	, m_asleep(false)
+	, m_restTime(0.f)
+	, m_sleepSpeed(1.f)
+	, m_sleepForce(1.f)
+	, m_sleepDelay(0.5f)
+	, m_wakeFlag(nullptr)
+	, m_id(nextId())
+	, m_handle()
+	, m_registry(nullptr)
+	, m_random(m_id)
 {
 
 }
 
 steer::Agent::Agent(Vector2 position, float radius, Vector2 velocity, Vector2 heading, Vector2 side, float mass, float maxSpeed, float maxForce, float maxTurnRate)
 	: m_scale(Vector2(1.f, 1.f))
+	, m_rotation(0.f)
 	, m_boundingRadius(0.f)
 	, m_tag(false)
 	, m_steeringForce(Vector2(0.0, 0.0))
 	, m_waypointSeekDistanceSquared(0.f)
-	, m_feelers(3)
+	, m_feelers()
+	, m_cellSpace(nullptr)
+	, m_doubleBuffered(false)
 	, m_velocity(velocity)
 	, m_heading(heading)
 	, m_side(side)
@@ -58,6 +89,7 @@ steer::Agent::Agent(Vector2 position, float radius, Vector2 velocity, Vector2 he
 	, m_maxSpeed(maxSpeed)
 	, m_maxForce(maxForce)
 	, m_maxTurnRate(maxTurnRate)
+	, m_summingMethod(steer::summingMethod::weightedSum)
 	, m_target(Vector2(0.0, 0.0))
 	, m_threatRange(0.f)
 	, m_decelerationTweaker(1.f)
@@ -66,6 +98,17 @@ steer::Agent::Agent(Vector2 position, float radius, Vector2 velocity, Vector2 he
 	, m_wanderJitter(0.f)
 	, m_wanderRadius(0.f)
 	, m_wanderDistance(0.f)
+	, m_externalForce(Vector2(0.0, 0.0))
+	, m_asleep(false)
+	, m_restTime(0.f)
+	, m_sleepSpeed(1.f)
+	, m_sleepForce(1.f)
+	, m_sleepDelay(0.5f)
+	, m_wakeFlag(nullptr)
+	, m_id(nextId())
+	, m_handle()
+	, m_registry(nullptr)
+	, m_random(m_id)
 {
 	setPosition(position);
 	setBoundingRadius(radius);
@@ -73,11 +116,14 @@ steer::Agent::Agent(Vector2 position, float radius, Vector2 velocity, Vector2 he
 
 steer::Agent::Agent(steer::BehaviorParameters* params)
 	: m_scale(params->VehicleScale, params->VehicleScale)
+	, m_rotation(0.f)
 	, m_boundingRadius(params->radius)
 	, m_tag(false)
 	, m_steeringForce(Vector2(0.0, 0.0))
 	, m_waypointSeekDistanceSquared(params->waypointSeekDistance*params->waypointSeekDistance)
-	, m_feelers(3)
+	, m_feelers()
+	, m_cellSpace(nullptr)
+	, m_doubleBuffered(false)
 	, m_velocity(params->velocity)
 	, m_heading(params->heading)
 	, m_side(params->side)
@@ -91,6 +137,7 @@ steer::Agent::Agent(steer::BehaviorParameters* params)
 	, m_maxSpeed(params->MaxSpeed)
 	, m_maxForce(params->MaxForce)
 	, m_maxTurnRate(params->MaxTurnRate)
+	, m_summingMethod(params->SummingMethod)
 	, m_target(Vector2(0.0, 0.0))
 	, m_threatRange(params->ThreatRange)
 	, m_decelerationTweaker(params->DecelerationTweaker)
@@ -99,6 +146,17 @@ steer::Agent::Agent(steer::BehaviorParameters* params)
 	, m_wanderJitter(params->wanderJitterPerSecond)
 	, m_wanderRadius(params->wanderRadius)
 	, m_wanderDistance(params->wanderDistance)
+	, m_externalForce(Vector2(0.0, 0.0))
+	, m_asleep(false)
+	, m_restTime(0.f)
+	, m_sleepSpeed(params->SleepSpeed)
+	, m_sleepForce(params->SleepForce)
+	, m_sleepDelay(params->SleepDelay)
+	, m_wakeFlag(nullptr)
+	, m_id(nextId())
+	, m_handle()
+	, m_registry(nullptr)
+	, m_random(m_id)
 {
 	setPosition(params->position);
 	setBoundingRadius(params->radius);
@@ -106,7 +164,18 @@ steer::Agent::Agent(steer::BehaviorParameters* params)
 
 steer::Agent::~Agent()
 {
+	setCellSpace(nullptr);
+}
+
+void steer::Agent::setCellSpace(SpatialHashGrid* grid)
+{
+	if (m_cellSpace != nullptr)
+		m_cellSpace->unregisterEntity(this);
+
+	m_cellSpace = grid;
 
+	if (m_cellSpace != nullptr)
+		m_cellSpace->registerEntity(this);
 }
 
 bool steer::Agent::rotateHeadingToFacePosition(Vector2 target)
@@ -154,16 +223,187 @@ void steer::Agent::createFeelers()
 	m_feelers[2] = getPosition() + m_wallDetectionFeelerLength / 2.0f * temp;
 }
 
-void steer::Agent::setSummingMethod(Uint32 sumMethod)
+void steer::Agent::setDoubleBuffered(bool doubleBuffered)
 {
+	if (doubleBuffered == m_doubleBuffered)
+		return;
+
+	if (doubleBuffered)
+	{
+		//start out publishing the current state, which is also
+		//where the partition has the agent binned
+		m_published.position = m_agentPosition;
+		m_published.velocity = m_velocity;
+		m_published.heading = m_heading;
 
+		m_doubleBuffered = true;
+	}
+	else
+	{
+		//publish whatever was written since the last frame
+		publishState();
+
+		m_doubleBuffered = false;
+	}
 }
 
-bool steer::Agent::accumulateForce(Vector2 &runningTotal, Vector2 forceToAdd)
+void steer::Agent::publishState()
+{
+	if (!m_doubleBuffered)
+		return;
+
+	Vector2 oldPosition = m_published.position;
+
+	m_published.position = m_agentPosition;
+	m_published.velocity = m_velocity;
+	m_published.heading = m_heading;
+
+	//the partition bins the agent at its published position
+	if (m_cellSpace != nullptr)
+		m_cellSpace->updateEntity(this, oldPosition);
+}
+
+void steer::Agent::integrate(float dt)
+{
+	STEERIOUSLY_PROFILE_SCOPE(steer::profile::integrate);
+
+	//keep a record of its old position so we can update its cell later
+	//in this method
+	Vector2 OldPosition = getPosition();
+
+	//Acceleration = Force/Mass, external forces only push for one frame
+	Vector2 acceleration = (m_steeringForce + m_externalForce) / getMass();
+
+	m_externalForce = Vector2(0.0, 0.0);
+
+	//update velocity
+	m_velocity += acceleration * dt;
+
+	//make sure vehicle does not exceed maximum velocity
+	m_velocity = VectorMath::truncate(m_velocity, getMaxSpeed());
+
+	//update the position
+	m_agentPosition += m_velocity * dt;
+	m_rotation = VectorMath::findAngle(m_velocity);
+
+	//update the heading if the vehicle has a non zero velocity
+	if (VectorMath::lengthSquared(m_velocity) > 0.00000001f)
+	{
+		m_heading = VectorMath::normalize(m_velocity);
+
+		m_side = VectorMath::perpendicular(m_heading);
+	}
+
+	//move the agent between cells of the partition if it
+	//crossed a cell boundary
+	updateCell(OldPosition);
+}
+
+void steer::Agent::sleep()
+{
+	if (m_asleep)
+		return;
+
+	m_asleep = true;
+	m_restTime = 0.f;
+	m_velocity = Vector2(0.0, 0.0);
+	m_steeringForce = Vector2(0.0, 0.0);
+
+	if (m_wakeFlag != nullptr)
+		*m_wakeFlag = true;
+}
+
+void steer::Agent::wake()
+{
+	m_restTime = 0.f;
+
+	if (!m_asleep)
+		return;
+
+	m_asleep = false;
+
+	if (m_wakeFlag != nullptr)
+		*m_wakeFlag = true;
+}
+
+void steer::Agent::applyForce(const steer::Vector2 force)
+{
+	m_externalForce += force;
+
+	wake();
+}
+
+bool steer::Agent::updateRest(float dt)
 {
+	if (m_asleep || m_sleepDelay <= 0.f)
+		return false;
+
+	//an agent that is pushed around or steering somewhere is not at rest
+	if (VectorMath::lengthSquared(m_velocity) > m_sleepSpeed * m_sleepSpeed ||
+		VectorMath::lengthSquared(m_steeringForce) > m_sleepForce * m_sleepForce ||
+		VectorMath::lengthSquared(m_externalForce) > 0.f)
+	{
+		m_restTime = 0.f;
+		return false;
+	}
+
+	m_restTime += dt;
+
+	if (m_restTime < m_sleepDelay)
+		return false;
+
+	m_asleep = true;
+	m_restTime = 0.f;
+	m_velocity = Vector2(0.0, 0.0);
+	m_steeringForce = Vector2(0.0, 0.0);
+
 	return true;
 }
 
+void steer::Agent::setSummingMethod(Uint32 sumMethod)
+{
+	m_summingMethod = sumMethod;
+}
+
+//---------------------- AccumulateForce ---------------------------------
+//
+//  this function calculates how much of its max steering force the
+//  vehicle has left to apply and then applies that amount of the
+//  force to add. Returns false once the budget is used up
+//------------------------------------------------------------------------
+bool steer::Agent::accumulateForce(Vector2 &runningTotal, Vector2 forceToAdd)
+{
+	//calculate how much steering force the vehicle has used so far
+	float magnitudeSoFar = VectorMath::length(runningTotal);
+
+	//calculate how much steering force remains to be used by this vehicle
+	float magnitudeRemaining = getMaxForce() - magnitudeSoFar;
+
+	//return false if there is no more force left to use
+	if (magnitudeRemaining <= 0.f)
+		return false;
+
+	//calculate the magnitude of the force we want to add
+	float magnitudeToAdd = VectorMath::length(forceToAdd);
+
+	//if the magnitude of the sum of forceToAdd and the running total
+	//does not exceed the maximum force available to this vehicle, just
+	//add together. Otherwise add as much of the forceToAdd vector is
+	//possible without going over the max.
+	if (magnitudeToAdd < magnitudeRemaining)
+	{
+		runningTotal += forceToAdd;
+
+		return true;
+	}
+
+	//add it to the steering force, which uses up the budget - the
+	//behaviors further down are not evaluated
+	runningTotal += VectorMath::normalize(forceToAdd) * magnitudeRemaining;
+
+	return false;
+}
+
 //---------------------- CalculatePrioritized ----------------------------
 //
 //  this method calls each active steering behavior in order of priority
@@ -177,6 +417,20 @@ Vector2 steer::Agent::calculatePrioritized()
 }
 
 
+//---------------------- CalculateDithered -------------------------------
+//
+//  this method sums up the active behaviors by assigning a probabilty
+//  of being calculated to each behavior. It then tests the first priority
+//  to see if it should be calculated this simulation-step. If so, it
+//  calculates the steering force resulting from this behavior. If it is
+//  more than zero it returns the force. If zero, or if the behavior is
+//  skipped it continues onto the next priority, and so on.
+//------------------------------------------------------------------------
+Vector2 steer::Agent::calculateDithered()
+{
+	return Vector2(0.0, 0.0);
+}
+
 //---------------------- CalculateWeightedSum ----------------------------
 //
 //  this simply sums up all the active behaviors X their weights and
@@ -0,0 +1,64 @@
+#include <assert.h>
+
+#include <steeriously/AgentRegistry.hpp>
+#include <steeriously/Agent.hpp>
+
+using namespace steer;
+
+steer::AgentRef::AgentRef(Agent* a)
+: agent(a)
+, handle(a != nullptr ? a->getHandle() : AgentHandle())
+, registry(a != nullptr ? a->getRegistry() : nullptr)
+{
+
+}
+
+steer::AgentRegistry::AgentRegistry()
+: m_size(0)
+{
+
+}
+
+AgentHandle steer::AgentRegistry::add(Agent* agent)
+{
+    assert(agent != nullptr);
+
+    ++m_size;
+
+    if (m_free.empty())
+    {
+        Slot slot = { agent, 1 };
+
+        m_slots.push_back(slot);
+
+        return AgentHandle((Uint32)m_slots.size() - 1, 1);
+    }
+
+    Uint32 index = m_free.back();
+    m_free.pop_back();
+
+    //removal left the generation even, the next odd one is alive
+    m_slots[index].agent = agent;
+    ++m_slots[index].generation;
+
+    return AgentHandle(index, m_slots[index].generation);
+}
+
+void steer::AgentRegistry::remove(AgentHandle handle)
+{
+    if (resolve(handle) == nullptr)
+        return;
+
+    m_slots[handle.index].agent = nullptr;
+    ++m_slots[handle.index].generation;
+    m_free.push_back(handle.index);
+
+    --m_size;
+}
+
+void steer::AgentRegistry::relocate(AgentHandle handle, Agent* agent)
+{
+    assert(resolve(handle) != nullptr && "<AgentRegistry::relocate> stale handle");
+
+    m_slots[handle.index].agent = agent;
+}
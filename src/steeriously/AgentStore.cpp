@@ -0,0 +1,117 @@
+#include <math.h>
+
+#include <steeriously/AgentStore.hpp>
+#include <steeriously/Profiler.hpp>
+
+using namespace steer;
+
+namespace
+{
+    //the arrays never overlap, restrict qualified parameters tell the
+    //compiler so and spare it from checking every pair of them before
+    //running the vectorized loop
+    template <class T>
+    void integrateArrays(std::size_t begin, std::size_t end, float dt,
+                         T* __restrict px, T* __restrict py,
+                         T* __restrict vx, T* __restrict vy,
+                         T* __restrict hx, T* __restrict hy,
+                         T* __restrict sx, T* __restrict sy,
+                         const T* __restrict fx, const T* __restrict fy,
+                         const float* __restrict mass, const float* __restrict maxSpeed)
+    {
+        //every branch of Agent::integrate is written as a select so the
+        //loop body is straight line code the compiler can vectorize, the
+        //lengths are taken in float as VectorMath takes them so both give
+        //the same result
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            //Acceleration = Force/Mass
+            T velX = vx[i] + fx[i] / T(mass[i]) * T(dt);
+            T velY = vy[i] + fy[i] / T(mass[i]) * T(dt);
+
+            //make sure vehicle does not exceed maximum velocity - a zero
+            //speed divides to infinity and clamps to one
+            float truncate = maxSpeed[i] / sqrtf((float)(velX * velX + velY * velY));
+            truncate = truncate < 1.f ? truncate : 1.f;
+
+            velX *= T(truncate);
+            velY *= T(truncate);
+
+            vx[i] = velX;
+            vy[i] = velY;
+
+            //update the position
+            px[i] += velX * T(dt);
+            py[i] += velY * T(dt);
+
+            //update the heading if the vehicle has a non zero velocity
+            float speedSq = (float)(velX * velX + velY * velY);
+
+            bool moving = speedSq > 0.00000001f;
+            T speed = T(moving ? sqrtf(speedSq) : 1.f);
+
+            T headX = moving ? velX / speed : hx[i];
+            T headY = moving ? velY / speed : hy[i];
+
+            hx[i] = headX;
+            hy[i] = headY;
+
+            sx[i] = -headY;
+            sy[i] = headX;
+        }
+    }
+}
+
+steer::AgentStore::AgentStore()
+: m_size(0)
+{
+
+}
+
+steer::AgentStore::~AgentStore()
+{
+
+}
+
+void steer::AgentStore::resize(Uint32 count)
+{
+    m_positionX.resize(count, Scalar(0));
+    m_positionY.resize(count, Scalar(0));
+    m_velocityX.resize(count, Scalar(0));
+    m_velocityY.resize(count, Scalar(0));
+    m_headingX.resize(count, Scalar(0));
+    m_headingY.resize(count, Scalar(0));
+    m_sideX.resize(count, Scalar(0));
+    m_sideY.resize(count, Scalar(0));
+    m_forceX.resize(count, Scalar(0));
+    m_forceY.resize(count, Scalar(0));
+    m_mass.resize(count, 1.f);
+    m_maxSpeed.resize(count, 0.f);
+
+    m_size = count;
+}
+
+void steer::AgentStore::clear()
+{
+    resize(0);
+}
+
+void steer::AgentStore::integrate(float dt)
+{
+    integrate(0, m_size, dt);
+}
+
+void steer::AgentStore::integrate(Uint32 begin, Uint32 end, float dt)
+{
+    STEERIOUSLY_PROFILE_SCOPE(steer::profile::integrate);
+
+    assert(end <= m_size);
+
+    integrateArrays(begin, end, dt,
+                    m_positionX.data(), m_positionY.data(),
+                    m_velocityX.data(), m_velocityY.data(),
+                    m_headingX.data(), m_headingY.data(),
+                    m_sideX.data(), m_sideY.data(),
+                    m_forceX.data(), m_forceY.data(),
+                    m_mass.data(), m_maxSpeed.data());
+}
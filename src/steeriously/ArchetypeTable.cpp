@@ -0,0 +1,299 @@
+#include <algorithm>
+#include <assert.h>
+#include <unordered_map>
+
+#include <steeriously/ArchetypeTable.hpp>
+#include <steeriously/Profiler.hpp>
+#include <steeriously/Steeriously.hpp>
+#include <steeriously/components/SuperComponent.hpp>
+
+using namespace steer;
+
+namespace
+{
+    //the behaviors of a weighted sum, one step each - SuperComponent's
+    //weighted sum and the archetype kernels both run them
+
+    void evadeStep(SuperComponent& agent, Vector2& force)
+    {
+        SuperComponent* self = &agent;
+
+        force = Evade(self, agent.getEvadeAgent()) * agent.m_weightEvade;
+    }
+
+    void flockingStep(SuperComponent& agent, Vector2& force)
+    {
+        //all three in one pass over the neighbors
+        FlockingForces flock = agent.flockingForces();
+
+        force += flock.separation * agent.m_weightSeparation;
+        force += flock.alignment * agent.m_weightAlignment;
+        force += flock.cohesion * agent.m_weightCohesion;
+    }
+
+    void separationStep(SuperComponent& agent, Vector2& force)
+    {
+        force += agent.separationForce() * agent.m_weightSeparation;
+    }
+
+    void alignmentStep(SuperComponent& agent, Vector2& force)
+    {
+        force += agent.alignmentForce() * agent.m_weightAlignment;
+    }
+
+    void cohesionStep(SuperComponent& agent, Vector2& force)
+    {
+        force += agent.cohesionForce() * agent.m_weightCohesion;
+    }
+
+    void wanderStep(SuperComponent& agent, Vector2& force)
+    {
+        SuperComponent* self = &agent;
+
+        force = Wander(self) * agent.m_weightWander;
+    }
+
+    void seekStep(SuperComponent& agent, Vector2& force)
+    {
+        SuperComponent* self = &agent;
+
+        force += Seek(self) * agent.m_weightSeek;
+    }
+
+    void fleeStep(SuperComponent& agent, Vector2& force)
+    {
+        SuperComponent* self = &agent;
+
+        force += Flee(self) * agent.m_weightFlee;
+    }
+
+    void arriveStep(SuperComponent& agent, Vector2& force)
+    {
+        SuperComponent* self = &agent;
+
+        force += Arrive(self, agent.m_deceleration) * agent.m_weightArrive;
+    }
+
+    void pursuitStep(SuperComponent& agent, Vector2& force)
+    {
+        assert(agent.getPursuitAgent() && "pursuit target not assigned");
+
+        SuperComponent* self = &agent;
+
+        force += Pursuit(self, agent.getPursuitAgent()) * agent.m_weightPursuit;
+    }
+
+    void offsetPursuitStep(SuperComponent& agent, Vector2& force)
+    {
+        assert(agent.getLeader() && "pursuit target not assigned");
+        assert(!agent.getOffset().isZero() && "No offset assigned");
+
+        SuperComponent* self = &agent;
+
+        force += OffsetPursuit(self, agent.getLeader(), *agent.getParams()) * agent.m_weightOffsetPursuit;
+    }
+
+    void interposeStep(SuperComponent& agent, Vector2& force)
+    {
+        assert(agent.getInterposeAgentA() && agent.getInterposeAgentB() && "Interpose agents not assigned");
+
+        SuperComponent* self = &agent;
+
+        force += Interpose(self, agent.getInterposeAgentA(), agent.getInterposeAgentB(), *agent.getParams()) * agent.m_weightInterpose;
+    }
+
+    void hideStep(SuperComponent& agent, Vector2& force)
+    {
+        assert(agent.getHideAgent() && "Hide target not assigned");
+
+        force += agent.hideForce() * agent.m_weightHide;
+    }
+
+    void pathFollowingStep(SuperComponent& agent, Vector2& force)
+    {
+        force += agent.pathFollowingForce() * agent.m_weightPathFollowing;
+    }
+
+    void wallAvoidanceStep(SuperComponent& agent, Vector2& force)
+    {
+        force += agent.wallAvoidanceForce() * agent.m_weightWallAvoidance;
+    }
+
+    void obstacleAvoidanceStep(SuperComponent& agent, Vector2& force)
+    {
+        force += agent.obstacleAvoidanceForce() * agent.m_weightObstacleAvoidance;
+    }
+
+    bool has(Uint32 flags, Uint32 behavior)
+    {
+        return (flags & behavior) == behavior;
+    }
+
+    const Uint32 flockingFlags = behaviorType::separation | behaviorType::alignment | behaviorType::cohesion;
+}
+
+steer::ArchetypeTable::ArchetypeTable()
+: m_window(1)
+{
+
+}
+
+void steer::ArchetypeTable::rebuild(const std::vector<SuperComponent*>& agents)
+{
+    //archetypes are numbered in the order they are first met
+    std::unordered_map<Uint64, Uint32> lookup;
+    std::vector<Uint32> archetypeOfAgent(agents.size());
+
+    m_archetypes.clear();
+
+    for (std::size_t i = 0; i < agents.size(); ++i)
+    {
+        Uint32 flags = agents[i]->getFlags();
+        Uint32 method = agents[i]->getSummingMethod();
+        Uint64 key = ((Uint64)method << 32) | flags;
+
+        auto it = lookup.find(key);
+
+        if (it == lookup.end())
+        {
+            Archetype archetype;
+            archetype.flags = flags;
+            archetype.summingMethod = method;
+            archetype.gatherNeighbors = (flags & flockingFlags) != 0;
+
+            if (method == summingMethod::weightedSum)
+                buildSteps(flags, archetype.steps);
+
+            it = lookup.insert(std::make_pair(key, (Uint32)m_archetypes.size())).first;
+            m_archetypes.push_back(archetype);
+        }
+
+        archetypeOfAgent[i] = it->second;
+    }
+
+    //group each window by archetype: count, turn the counts into
+    //runs, then scatter the agents of the window into them
+    Uint32 count = (Uint32)agents.size();
+    Uint32 window = m_window > 0 ? m_window : MaxOf(count, (Uint32)1);
+    const Uint32 noRun = ~(Uint32)0;
+    std::vector<Uint32> runOfArchetype(m_archetypes.size(), noRun);
+
+    m_agents.resize(count);
+    m_runs.clear();
+
+    for (Uint32 begin = 0; begin < count; begin += window)
+    {
+        Uint32 end = MinOf(begin + window, count);
+        std::size_t firstRun = m_runs.size();
+
+        for (Uint32 i = begin; i < end; ++i)
+        {
+            Uint32 archetype = archetypeOfAgent[i];
+
+            if (runOfArchetype[archetype] == noRun)
+            {
+                ArchetypeRun run = { archetype, 0, 0 };
+
+                runOfArchetype[archetype] = (Uint32)m_runs.size();
+                m_runs.push_back(run);
+            }
+
+            ++m_runs[runOfArchetype[archetype]].end;
+        }
+
+        Uint32 offset = begin;
+
+        for (std::size_t r = firstRun; r < m_runs.size(); ++r)
+        {
+            Uint32 size = m_runs[r].end;
+
+            m_runs[r].begin = offset;
+            m_runs[r].end = offset;
+            offset += size;
+        }
+
+        for (Uint32 i = begin; i < end; ++i)
+            m_agents[m_runs[runOfArchetype[archetypeOfAgent[i]]].end++] = agents[i];
+
+        for (std::size_t r = firstRun; r < m_runs.size(); ++r)
+            runOfArchetype[m_runs[r].archetype] = noRun;
+    }
+
+    //runs tile the table, neighbors of the same archetype become one
+    std::size_t merged = 0;
+
+    for (std::size_t r = 1; r < m_runs.size(); ++r)
+    {
+        if (m_runs[r].archetype == m_runs[merged].archetype)
+            m_runs[merged].end = m_runs[r].end;
+        else
+            m_runs[++merged] = m_runs[r];
+    }
+
+    if (!m_runs.empty())
+        m_runs.resize(merged + 1);
+}
+
+Uint32 steer::ArchetypeTable::runOf(Uint32 index) const
+{
+    auto it = std::upper_bound(m_runs.begin(), m_runs.end(), index, [](Uint32 i, const ArchetypeRun& run)
+    {
+        return i < run.end;
+    });
+
+    return (Uint32)(it - m_runs.begin());
+}
+
+Vector2 steer::ArchetypeTable::calculate(const Archetype& archetype, SuperComponent& agent)
+{
+    //the prioritized and dithered sums stop early or pick behaviors at
+    //random, they keep going through the agent
+    if (archetype.steps.empty())
+        return agent.Calculate();
+
+    STEERIOUSLY_PROFILE_SCOPE(steer::profile::calculate);
+
+    if (archetype.gatherNeighbors)
+        agent.tagNeighbors();
+    else
+        agent.m_neighborhood.clear();
+
+    Vector2 force(0.0, 0.0);
+
+    for (auto step : archetype.steps)
+        step(agent, force);
+
+    agent.m_steeringForce = VectorMath::truncate(force, agent.getMaxForce());
+
+    return agent.m_steeringForce;
+}
+
+void steer::ArchetypeTable::buildSteps(Uint32 flags, std::vector<ArchetypeStep>& steps)
+{
+    steps.clear();
+
+    if (has(flags, behaviorType::evade)) steps.push_back(&evadeStep);
+
+    if (has(flags, flockingFlags))
+    {
+        steps.push_back(&flockingStep);
+    }
+    else
+    {
+        if (has(flags, behaviorType::separation)) steps.push_back(&separationStep);
+        if (has(flags, behaviorType::alignment)) steps.push_back(&alignmentStep);
+        if (has(flags, behaviorType::cohesion)) steps.push_back(&cohesionStep);
+    }
+
+    if (has(flags, behaviorType::wander)) steps.push_back(&wanderStep);
+    if (has(flags, behaviorType::seek)) steps.push_back(&seekStep);
+    if (has(flags, behaviorType::flee)) steps.push_back(&fleeStep);
+    if (has(flags, behaviorType::arrive)) steps.push_back(&arriveStep);
+    if (has(flags, behaviorType::pursuit)) steps.push_back(&pursuitStep);
+    if (has(flags, behaviorType::offsetPursuit)) steps.push_back(&offsetPursuitStep);
+    if (has(flags, behaviorType::interpose)) steps.push_back(&interposeStep);
+    if (has(flags, behaviorType::hide)) steps.push_back(&hideStep);
+    if (has(flags, behaviorType::followPath)) steps.push_back(&pathFollowingStep);
+    if (has(flags, behaviorType::wallAvoidance)) steps.push_back(&wallAvoidanceStep);
+    if (has(flags, behaviorType::obstacleAvoidance)) steps.push_back(&obstacleAvoidanceStep);
+}
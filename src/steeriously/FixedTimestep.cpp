@@ -0,0 +1,113 @@
+#include <assert.h>
+
+#include <steeriously/FixedTimestep.hpp>
+#include <steeriously/VectorMath.hpp>
+#include <steeriously/World.hpp>
+#include <steeriously/components/SuperComponent.hpp>
+
+using namespace steer;
+
+steer::FixedTimestep::FixedTimestep(World& world, float rate)
+: m_world(world)
+, m_step(0.f)
+, m_accumulator(0.f)
+, m_maxSteps(5)
+{
+    setRate(rate);
+}
+
+void steer::FixedTimestep::setRate(float rate)
+{
+    assert(rate > 0.f);
+
+    m_step = 1.f / rate;
+
+    //a lower rate may leave more than a step in the accumulator
+    m_accumulator = MinOf(m_accumulator, m_step);
+}
+
+Uint32 steer::FixedTimestep::advance(float frameTime)
+{
+    //past the most steps an advance runs the time is dropped, a slow
+    //frame must not make the next one slower still
+    m_accumulator = MinOf(m_accumulator + MaxOf(frameTime, 0.f), m_step * m_maxSteps);
+
+    Uint32 steps = 0;
+
+    while (m_accumulator >= m_step)
+    {
+        capture();
+        m_world.step(m_step);
+
+        m_accumulator -= m_step;
+        ++steps;
+    }
+
+    return steps;
+}
+
+Vector2 steer::FixedTimestep::getPosition(const Agent& agent) const
+{
+    const Snapshot* previous = find(agent);
+
+    if (previous == nullptr)
+        return agent.getPosition();
+
+    return previous->position + (agent.getPosition() - previous->position) * getAlpha();
+}
+
+Vector2 steer::FixedTimestep::getHeading(const Agent& agent) const
+{
+    const Snapshot* previous = find(agent);
+
+    if (previous == nullptr)
+        return agent.getHeading();
+
+    Vector2 heading = previous->heading + (agent.getHeading() - previous->heading) * getAlpha();
+
+    //headings turned all the way round blend to nothing
+    if (VectorMath::lengthSquared(heading) < MinFloat)
+        return agent.getHeading();
+
+    return VectorMath::normalize(heading);
+}
+
+void steer::FixedTimestep::snap()
+{
+    capture();
+}
+
+void steer::FixedTimestep::capture()
+{
+    const std::vector<SuperComponent*>& agents = m_world.getAgents();
+
+    for (auto& agent : agents)
+    {
+        AgentHandle handle = agent->getHandle();
+
+        if (handle.index >= m_previous.size())
+        {
+            Snapshot empty = { 0, Vector2(), Vector2() };
+
+            m_previous.resize(handle.index + 1, empty);
+        }
+
+        Snapshot& snapshot = m_previous[handle.index];
+
+        snapshot.generation = handle.generation;
+        snapshot.position = agent->getPosition();
+        snapshot.heading = agent->getHeading();
+    }
+}
+
+const FixedTimestep::Snapshot* steer::FixedTimestep::find(const Agent& agent) const
+{
+    //agents that joined or replaced a removed agent since the last step
+    //have no state of their own from before it
+    AgentHandle handle = agent.getHandle();
+
+    if (!handle.isValid() || handle.index >= m_previous.size() || m_previous[handle.index].generation != handle.generation)
+        return nullptr;
+
+    return &m_previous[handle.index];
+}
@@ -0,0 +1,150 @@
+#include <steeriously/FlockingKernel.hpp>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define STEERIOUSLY_FLOCKING_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define STEERIOUSLY_FLOCKING_SSE
+#endif
+
+using namespace steer;
+
+namespace
+{
+#if defined(STEERIOUSLY_FLOCKING_AVX2)
+    float horizontalSum(__m256 v)
+    {
+        __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+        return _mm_cvtss_f32(sum);
+    }
+#elif defined(STEERIOUSLY_FLOCKING_SSE)
+    float horizontalSum(__m128 v)
+    {
+        __m128 sum = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+        return _mm_cvtss_f32(sum);
+    }
+#endif
+}
+
+FlockingSums steer::SumNeighborPack(const NeighborPack& pack)
+{
+    const float* ox = pack.m_offsetX.data();
+    const float* oy = pack.m_offsetY.data();
+    const float* hx = pack.m_headingX.data();
+    const float* hy = pack.m_headingY.data();
+
+    Uint32 count = pack.size();
+    Uint32 i = 0;
+
+    float separationX = 0.f;
+    float separationY = 0.f;
+    float headingX = 0.f;
+    float headingY = 0.f;
+    float offsetX = 0.f;
+    float offsetY = 0.f;
+
+#if defined(STEERIOUSLY_FLOCKING_AVX2)
+    __m256 sepX = _mm256_setzero_ps();
+    __m256 sepY = _mm256_setzero_ps();
+    __m256 sumHX = _mm256_setzero_ps();
+    __m256 sumHY = _mm256_setzero_ps();
+    __m256 sumOX = _mm256_setzero_ps();
+    __m256 sumOY = _mm256_setzero_ps();
+    const __m256 zero = _mm256_setzero_ps();
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 x = _mm256_loadu_ps(ox + i);
+        __m256 y = _mm256_loadu_ps(oy + i);
+
+        //offset / |offset|^2 - the normalized offset divided by its
+        //length without the sqrt, neighbors sitting on top of the
+        //agent are masked out
+        __m256 lengthSq = _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y));
+        __m256 valid = _mm256_cmp_ps(lengthSq, zero, _CMP_GT_OQ);
+
+        sepX = _mm256_add_ps(sepX, _mm256_and_ps(valid, _mm256_div_ps(x, lengthSq)));
+        sepY = _mm256_add_ps(sepY, _mm256_and_ps(valid, _mm256_div_ps(y, lengthSq)));
+
+        sumHX = _mm256_add_ps(sumHX, _mm256_loadu_ps(hx + i));
+        sumHY = _mm256_add_ps(sumHY, _mm256_loadu_ps(hy + i));
+
+        sumOX = _mm256_add_ps(sumOX, x);
+        sumOY = _mm256_add_ps(sumOY, y);
+    }
+
+    separationX = horizontalSum(sepX);
+    separationY = horizontalSum(sepY);
+    headingX = horizontalSum(sumHX);
+    headingY = horizontalSum(sumHY);
+    offsetX = horizontalSum(sumOX);
+    offsetY = horizontalSum(sumOY);
+#elif defined(STEERIOUSLY_FLOCKING_SSE)
+    __m128 sepX = _mm_setzero_ps();
+    __m128 sepY = _mm_setzero_ps();
+    __m128 sumHX = _mm_setzero_ps();
+    __m128 sumHY = _mm_setzero_ps();
+    __m128 sumOX = _mm_setzero_ps();
+    __m128 sumOY = _mm_setzero_ps();
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(ox + i);
+        __m128 y = _mm_loadu_ps(oy + i);
+
+        //offset / |offset|^2 - the normalized offset divided by its
+        //length without the sqrt, neighbors sitting on top of the
+        //agent are masked out
+        __m128 lengthSq = _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y));
+        __m128 valid = _mm_cmpgt_ps(lengthSq, zero);
+
+        sepX = _mm_add_ps(sepX, _mm_and_ps(valid, _mm_div_ps(x, lengthSq)));
+        sepY = _mm_add_ps(sepY, _mm_and_ps(valid, _mm_div_ps(y, lengthSq)));
+
+        sumHX = _mm_add_ps(sumHX, _mm_loadu_ps(hx + i));
+        sumHY = _mm_add_ps(sumHY, _mm_loadu_ps(hy + i));
+
+        sumOX = _mm_add_ps(sumOX, x);
+        sumOY = _mm_add_ps(sumOY, y);
+    }
+
+    separationX = horizontalSum(sepX);
+    separationY = horizontalSum(sepY);
+    headingX = horizontalSum(sumHX);
+    headingY = horizontalSum(sumHY);
+    offsetX = horizontalSum(sumOX);
+    offsetY = horizontalSum(sumOY);
+#endif
+
+    //whatever is left over, or everything without SIMD
+    for (; i < count; ++i)
+    {
+        float lengthSq = ox[i] * ox[i] + oy[i] * oy[i];
+
+        if (lengthSq > 0.f)
+        {
+            separationX += ox[i] / lengthSq;
+            separationY += oy[i] / lengthSq;
+        }
+
+        headingX += hx[i];
+        headingY += hy[i];
+
+        offsetX += ox[i];
+        offsetY += oy[i];
+    }
+
+    FlockingSums sums;
+
+    //separation pushes away from the neighbors, the offsets point towards them
+    sums.separation = Vector2(-separationX, -separationY);
+    sums.heading = Vector2(headingX, headingY);
+    sums.offset = Vector2(offsetX, offsetY);
+
+    return sums;
+}
@@ -1,5 +1,13 @@
 #include <steeriously/GeometryHelpers.hpp>
 
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define STEERIOUSLY_RAY_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define STEERIOUSLY_RAY_SSE
+#endif
+
 bool steer::LineIntersection2D(Vector2 A, Vector2 B, Vector2 C, Vector2 D, float& dist, Vector2& point)
 {
 
@@ -34,3 +42,162 @@ bool steer::LineIntersection2D(Vector2 A, Vector2 B, Vector2 C, Vector2 D, float
         return false;
     }
 }
+
+bool steer::RaySegmentsIntersection(Vector2 A, Vector2 B, const float* fromX, const float* fromY, const float* toX, const float* toY, Uint32 count, RayHit& hit)
+{
+    float ax = (float)A.x;
+    float ay = (float)A.y;
+    float rayX = (float)(B.x - A.x);
+    float rayY = (float)(B.y - A.y);
+
+    float bestT = MaxFloat;
+    Int32 best = -1;
+    Uint32 i = 0;
+
+#if defined(STEERIOUSLY_RAY_AVX2) || defined(STEERIOUSLY_RAY_SSE)
+    //each lane keeps the nearest hit among the segments it saw,
+    //earlier segments win ties because a lane only takes a strictly
+    //nearer one
+    float laneT[8];
+    Int32 laneIndex[8];
+    Uint32 numLanes = 0;
+#endif
+
+#if defined(STEERIOUSLY_RAY_AVX2)
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.f);
+    const __m256 originX = _mm256_set1_ps(ax);
+    const __m256 originY = _mm256_set1_ps(ay);
+    const __m256 directionX = _mm256_set1_ps(rayX);
+    const __m256 directionY = _mm256_set1_ps(rayY);
+
+    __m256 nearest = _mm256_set1_ps(MaxFloat);
+    __m256i nearestIndex = _mm256_set1_epi32(-1);
+    __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i step = _mm256_set1_epi32(8);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 x0 = _mm256_loadu_ps(fromX + i);
+        __m256 y0 = _mm256_loadu_ps(fromY + i);
+
+        __m256 segX = _mm256_sub_ps(_mm256_loadu_ps(toX + i), x0);
+        __m256 segY = _mm256_sub_ps(_mm256_loadu_ps(toY + i), y0);
+        __m256 offX = _mm256_sub_ps(originX, x0);
+        __m256 offY = _mm256_sub_ps(originY, y0);
+
+        __m256 denominator = _mm256_sub_ps(_mm256_mul_ps(directionX, segY), _mm256_mul_ps(directionY, segX));
+
+        //parallel segments divide by zero, which fails every test below
+        __m256 r = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(offY, segX), _mm256_mul_ps(offX, segY)), denominator);
+        __m256 s = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(offY, directionX), _mm256_mul_ps(offX, directionY)), denominator);
+
+        __m256 accept = _mm256_and_ps(_mm256_cmp_ps(r, zero, _CMP_GT_OQ), _mm256_cmp_ps(r, one, _CMP_LT_OQ));
+        accept = _mm256_and_ps(accept, _mm256_and_ps(_mm256_cmp_ps(s, zero, _CMP_GT_OQ), _mm256_cmp_ps(s, one, _CMP_LT_OQ)));
+        accept = _mm256_and_ps(accept, _mm256_cmp_ps(r, nearest, _CMP_LT_OQ));
+
+        nearest = _mm256_blendv_ps(nearest, r, accept);
+        nearestIndex = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(nearestIndex), _mm256_castsi256_ps(index), accept));
+
+        index = _mm256_add_epi32(index, step);
+    }
+
+    _mm256_storeu_ps(laneT, nearest);
+    _mm256_storeu_si256((__m256i*)laneIndex, nearestIndex);
+    numLanes = 8;
+#elif defined(STEERIOUSLY_RAY_SSE)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 originX = _mm_set1_ps(ax);
+    const __m128 originY = _mm_set1_ps(ay);
+    const __m128 directionX = _mm_set1_ps(rayX);
+    const __m128 directionY = _mm_set1_ps(rayY);
+
+    __m128 nearest = _mm_set1_ps(MaxFloat);
+    __m128i nearestIndex = _mm_set1_epi32(-1);
+    __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+    const __m128i step = _mm_set1_epi32(4);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x0 = _mm_loadu_ps(fromX + i);
+        __m128 y0 = _mm_loadu_ps(fromY + i);
+
+        __m128 segX = _mm_sub_ps(_mm_loadu_ps(toX + i), x0);
+        __m128 segY = _mm_sub_ps(_mm_loadu_ps(toY + i), y0);
+        __m128 offX = _mm_sub_ps(originX, x0);
+        __m128 offY = _mm_sub_ps(originY, y0);
+
+        __m128 denominator = _mm_sub_ps(_mm_mul_ps(directionX, segY), _mm_mul_ps(directionY, segX));
+
+        //parallel segments divide by zero, which fails every test below
+        __m128 r = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(offY, segX), _mm_mul_ps(offX, segY)), denominator);
+        __m128 s = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(offY, directionX), _mm_mul_ps(offX, directionY)), denominator);
+
+        __m128 accept = _mm_and_ps(_mm_cmpgt_ps(r, zero), _mm_cmplt_ps(r, one));
+        accept = _mm_and_ps(accept, _mm_and_ps(_mm_cmpgt_ps(s, zero), _mm_cmplt_ps(s, one)));
+        accept = _mm_and_ps(accept, _mm_cmplt_ps(r, nearest));
+
+        //SSE2 has no blend, select with masks
+        nearest = _mm_or_ps(_mm_and_ps(accept, r), _mm_andnot_ps(accept, nearest));
+
+        __m128i take = _mm_castps_si128(accept);
+        nearestIndex = _mm_or_si128(_mm_and_si128(take, index), _mm_andnot_si128(take, nearestIndex));
+
+        index = _mm_add_epi32(index, step);
+    }
+
+    _mm_storeu_ps(laneT, nearest);
+    _mm_storeu_si128((__m128i*)laneIndex, nearestIndex);
+    numLanes = 4;
+#endif
+
+#if defined(STEERIOUSLY_RAY_AVX2) || defined(STEERIOUSLY_RAY_SSE)
+    for (Uint32 lane = 0; lane < numLanes; ++lane)
+    {
+        if (laneIndex[lane] < 0)
+            continue;
+
+        if (laneT[lane] < bestT || (laneT[lane] == bestT && laneIndex[lane] < best))
+        {
+            bestT = laneT[lane];
+            best = laneIndex[lane];
+        }
+    }
+#endif
+
+    //whatever is left over, or everything without SIMD - these come
+    //after every segment above, so they only win when strictly nearer
+    for (; i < count; ++i)
+    {
+        float segX = toX[i] - fromX[i];
+        float segY = toY[i] - fromY[i];
+        float offX = ax - fromX[i];
+        float offY = ay - fromY[i];
+
+        float denominator = rayX * segY - rayY * segX;
+
+        //parallel
+        if (denominator == 0.f)
+            continue;
+
+        float r = (offY * segX - offX * segY) / denominator;
+        float s = (offY * rayX - offX * rayY) / denominator;
+
+        if (r > 0.f && r < 1.f && s > 0.f && s < 1.f && r < bestT)
+        {
+            bestT = r;
+            best = (Int32)i;
+        }
+    }
+
+    if (best < 0)
+        return false;
+
+    hit.index = (Uint32)best;
+    hit.t = bestT;
+    hit.distance = steer::VectorMath::distance(A, B) * bestT;
+    hit.point = A + bestT * (B - A);
+
+    return true;
+}
@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <cassert>
+
+#include <steeriously/LodScheduler.hpp>
+#include <steeriously/VectorMath.hpp>
+
+using namespace steer;
+
+steer::LodScheduler::LodScheduler()
+{
+    LodTier full = { MaxFloat, 1 };
+
+    m_tiers.push_back(full);
+}
+
+void steer::LodScheduler::setTiers(const std::vector<steer::LodTier>& tiers)
+{
+    assert(!tiers.empty());
+
+    m_tiers = tiers;
+
+    std::sort(m_tiers.begin(), m_tiers.end(), [](const LodTier& a, const LodTier& b)
+    {
+        return a.maxDistance < b.maxDistance;
+    });
+
+    //an interval of zero would never update the agent
+    for (auto& tier : m_tiers)
+        tier.interval = MaxOf(tier.interval, (Uint32)1);
+}
+
+void steer::LodScheduler::setFocus(steer::Vector2 focus)
+{
+    m_focus.clear();
+    m_focus.push_back(focus);
+}
+
+Uint32 steer::LodScheduler::tierOf(const steer::Agent& agent) const
+{
+    Uint32 last = (Uint32)m_tiers.size() - 1;
+
+    if (!m_priorities.empty())
+    {
+        auto it = m_priorities.find(agent.getId());
+
+        if (it != m_priorities.end())
+            return MinOf(it->second, last);
+    }
+
+    if (m_focus.empty())
+        return 0;
+
+    float nearestSq = MaxFloat;
+
+    for (auto& focus : m_focus)
+        nearestSq = MinOf(nearestSq, VectorMath::distanceSquared(agent.getPosition(), focus));
+
+    for (Uint32 i = 0; i < last; ++i)
+    {
+        if (nearestSq < m_tiers[i].maxDistance * m_tiers[i].maxDistance)
+            return i;
+    }
+
+    return last;
+}
+
+bool steer::LodScheduler::isDue(const steer::Agent& agent, Uint64 tick) const
+{
+    Uint32 interval = m_tiers[tierOf(agent)].interval;
+
+    //offsetting the tick by the id spreads the agents of a tier
+    //evenly over its interval
+    return interval == 1 || (tick + agent.getId()) % interval == 0;
+}
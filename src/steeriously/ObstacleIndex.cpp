@@ -0,0 +1,216 @@
+#include <math.h>
+#include <algorithm>
+#include <queue>
+
+#include <steeriously/ObstacleIndex.hpp>
+
+using namespace steer;
+
+namespace
+{
+    //small leaves are scanned faster than they are descended into
+    const Uint32 LeafSize = 4;
+
+    float distanceSquaredToBox(float x, float y, float minX, float minY, float maxX, float maxY)
+    {
+        float dx = MaxOf(MaxOf(minX - x, 0.f), x - maxX);
+        float dy = MaxOf(MaxOf(minY - y, 0.f), y - maxY);
+
+        return dx*dx + dy*dy;
+    }
+
+    //a node or an obstacle waiting in the best first search,
+    //the smallest distance comes out of the queue first
+    struct Candidate
+    {
+        float   distanceSq;
+        Uint32  index;
+        bool    leafItem;
+
+        bool operator<(const Candidate& rhs) const { return distanceSq > rhs.distanceSq; }
+    };
+}
+
+steer::ObstacleIndex::ObstacleIndex()
+{
+}
+
+steer::ObstacleIndex::ObstacleIndex(const std::vector<steer::SphereObstacle*>& obstacles)
+{
+    build(obstacles);
+}
+
+void steer::ObstacleIndex::build(const std::vector<steer::SphereObstacle*>& obstacles)
+{
+    m_nodes.clear();
+    m_obstacles.clear();
+
+    for (auto& ob : obstacles)
+    {
+        if (ob == nullptr)
+            continue;
+
+        Item item = { (float)ob->getPosition().x, (float)ob->getPosition().y, ob->getRadius(), ob };
+        m_obstacles.push_back(item);
+    }
+
+    if (m_obstacles.empty())
+        return;
+
+    //a binary tree with n / LeafSize leaves has fewer than twice as many nodes
+    m_nodes.reserve(2 * (m_obstacles.size() / LeafSize + 1));
+
+    buildNode(0, (Uint32)m_obstacles.size());
+}
+
+Uint32 steer::ObstacleIndex::buildNode(Uint32 begin, Uint32 end)
+{
+    Uint32 index = (Uint32)m_nodes.size();
+    m_nodes.push_back(Node());
+
+    Node node = { MaxFloat, MaxFloat, -MaxFloat, -MaxFloat, begin, end - begin };
+
+    //bounds of the obstacles, and of their centers to pick the split axis from
+    float centerMinX = MaxFloat, centerMinY = MaxFloat;
+    float centerMaxX = -MaxFloat, centerMaxY = -MaxFloat;
+
+    for (Uint32 i = begin; i < end; ++i)
+    {
+        const Item& item = m_obstacles[i];
+
+        node.minX = MinOf(node.minX, item.x - item.radius);
+        node.minY = MinOf(node.minY, item.y - item.radius);
+        node.maxX = MaxOf(node.maxX, item.x + item.radius);
+        node.maxY = MaxOf(node.maxY, item.y + item.radius);
+
+        centerMinX = MinOf(centerMinX, item.x);
+        centerMinY = MinOf(centerMinY, item.y);
+        centerMaxX = MaxOf(centerMaxX, item.x);
+        centerMaxY = MaxOf(centerMaxY, item.y);
+    }
+
+    if (end - begin > LeafSize)
+    {
+        //split at the median along the longer axis of the centers
+        bool splitX = (centerMaxX - centerMinX) >= (centerMaxY - centerMinY);
+        Uint32 middle = begin + (end - begin) / 2;
+
+        std::nth_element(m_obstacles.begin() + begin, m_obstacles.begin() + middle, m_obstacles.begin() + end,
+            [splitX](const Item& a, const Item& b) { return splitX ? a.x < b.x : a.y < b.y; });
+
+        //the first child is built right after this node
+        buildNode(begin, middle);
+
+        node.first = buildNode(middle, end);
+        node.count = 0;
+    }
+
+    m_nodes[index] = node;
+
+    return index;
+}
+
+void steer::ObstacleIndex::query(steer::Vector2 min, steer::Vector2 max, std::vector<steer::SphereObstacle*>& result) const
+{
+    if (m_nodes.empty())
+        return;
+
+    float minX = (float)min.x, minY = (float)min.y;
+    float maxX = (float)max.x, maxY = (float)max.y;
+
+    //a balanced tree is only log2(n / LeafSize) deep, this is plenty
+    Uint32 stack[64];
+    Uint32 top = 0;
+
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        Uint32 current = stack[--top];
+        const Node& node = m_nodes[current];
+
+        if (node.maxX < minX || node.minX > maxX || node.maxY < minY || node.minY > maxY)
+            continue;
+
+        if (node.count > 0)
+        {
+            for (Uint32 i = node.first; i < node.first + node.count; ++i)
+            {
+                const Item& item = m_obstacles[i];
+
+                if (item.x + item.radius >= minX && item.x - item.radius <= maxX &&
+                    item.y + item.radius >= minY && item.y - item.radius <= maxY)
+                {
+                    result.push_back(item.obstacle);
+                }
+            }
+        }
+        else
+        {
+            stack[top++] = node.first;
+            stack[top++] = current + 1;
+        }
+    }
+}
+
+void steer::ObstacleIndex::nearest(steer::Vector2 position, Uint32 k, std::vector<steer::SphereObstacle*>& result) const
+{
+    if (m_nodes.empty() || k == 0)
+        return;
+
+    float x = (float)position.x;
+    float y = (float)position.y;
+
+    //best first - node bounds are never further than the obstacles inside
+    //them, so an obstacle coming out of the queue is closer than anything
+    //still in it
+    std::priority_queue<Candidate> queue;
+
+    Candidate root = { 0.f, 0, false };
+    queue.push(root);
+
+    Uint32 found = 0;
+
+    while (!queue.empty() && found < k)
+    {
+        Candidate candidate = queue.top();
+        queue.pop();
+
+        if (candidate.leafItem)
+        {
+            result.push_back(m_obstacles[candidate.index].obstacle);
+            ++found;
+            continue;
+        }
+
+        const Node& node = m_nodes[candidate.index];
+
+        if (node.count > 0)
+        {
+            for (Uint32 i = node.first; i < node.first + node.count; ++i)
+            {
+                const Item& item = m_obstacles[i];
+
+                //distance to the edge of the obstacle, zero inside it
+                float dx = item.x - x;
+                float dy = item.y - y;
+                float edge = MaxOf(sqrtf(dx*dx + dy*dy) - item.radius, 0.f);
+
+                Candidate next = { edge*edge, i, true };
+                queue.push(next);
+            }
+        }
+        else
+        {
+            Uint32 children[2] = { candidate.index + 1, node.first };
+
+            for (Uint32 c = 0; c < 2; ++c)
+            {
+                const Node& child = m_nodes[children[c]];
+
+                Candidate next = { distanceSquaredToBox(x, y, child.minX, child.minY, child.maxX, child.maxY), children[c], false };
+                queue.push(next);
+            }
+        }
+    }
+}
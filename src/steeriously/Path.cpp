@@ -5,28 +5,34 @@
 using namespace steer;
 
 steer::Path::Path()
-: m_looped(false)
-, m_currentWaypoint()
-, m_numWaypoints(0)
+: m_data(emptyData())
+, m_cursor(m_data.get())
 {
 
 }
 
 steer::Path::Path(int NumWaypoints, float MinX, float MinY, float MaxX, float MaxY, bool looped)
-: m_looped(looped)
-, m_numWaypoints(NumWaypoints)
+: m_data(emptyData())
+, m_cursor(m_data.get())
 {
-    createRandomPath(NumWaypoints, MinX, MinY, MaxX, MaxY);
+    if (looped)
+        loopOn();
 
-    m_currentWaypoint = m_wayPoints.begin();
+    createRandomPath(NumWaypoints, MinX, MinY, MaxX, MaxY);
 }
 
 steer::Path::Path(int NumWaypoints, std::list<Vector2>& waypoints)
-: m_looped(false)
-, m_numWaypoints(0)
-, m_wayPoints(waypoints)
+: m_data(emptyData())
+, m_cursor(m_data.get())
+{
+    set(waypoints);
+}
+
+steer::Path::Path(const std::vector<Vector2>& waypoints, bool looped)
+: m_data(std::make_shared<const PathData>(waypoints, looped))
+, m_cursor(m_data.get())
 {
-    m_currentWaypoint = m_wayPoints.begin();
+
 }
 
 steer::Path::~Path()
@@ -34,22 +40,38 @@ steer::Path::~Path()
 
 }
 
-void steer::Path::setNextWaypoint()
+const std::shared_ptr<const PathData>& steer::Path::emptyData()
 {
-  assert (m_wayPoints.size() > 0);
+    //every empty path shares one empty buffer, so default constructed
+    //paths do not allocate
+    static const std::shared_ptr<const PathData> empty = std::make_shared<const PathData>();
 
-  if (++m_currentWaypoint == m_wayPoints.end())
-  {
-    if (m_looped)
-    {
-      m_currentWaypoint = m_wayPoints.begin();
-    }
-  }
+    return empty;
+}
+
+void steer::Path::setData(const std::shared_ptr<const PathData>& data)
+{
+    //the loop option belongs to this path, not to the waypoints
+    bool looped = isLooped();
+
+    m_data = data;
+    m_cursor.set(m_data.get());
+
+    if (looped)
+        loopOn();
+    else
+        loopOff();
+}
+
+const std::vector<Vector2>& steer::Path::createRandomPath(int NumWaypoints, float MinX, float MinY, float MaxX, float MaxY)
+{
+    return createRandomPath(ThreadRandomStream(), NumWaypoints, MinX, MinY, MaxX, MaxY);
 }
 
-std::list<Vector2> steer::Path::createRandomPath(int NumWaypoints, float MinX, float MinY, float MaxX, float MaxY)
+const std::vector<Vector2>& steer::Path::createRandomPath(RandomStream& random, int NumWaypoints, float MinX, float MinY, float MaxX, float MaxY)
 {
-    m_wayPoints.clear();
+    std::vector<Vector2> wayPoints;
+    wayPoints.reserve(NumWaypoints);
 
     float midX = (MaxX+MinX)/2.0;
     float midY = (MaxY+MinY)/2.0;
@@ -60,7 +82,7 @@ std::list<Vector2> steer::Path::createRandomPath(int NumWaypoints, float MinX, f
 
     for (int i=0; i<NumWaypoints; ++i)
     {
-        float RadialDist = RandInRange(smaller*0.2f, smaller);
+        float RadialDist = RandInRange(random, smaller*0.2f, smaller);
 
         Vector2 temp(RadialDist, 0.0f);
 
@@ -69,10 +91,10 @@ std::list<Vector2> steer::Path::createRandomPath(int NumWaypoints, float MinX, f
         temp.x += midX;
         temp.y += midY;
 
-        m_wayPoints.push_back(temp);
+        wayPoints.push_back(temp);
     }
 
-    m_currentWaypoint = m_wayPoints.begin();
+    setData(std::make_shared<const PathData>(std::move(wayPoints), isLooped()));
 
-    return m_wayPoints;
+    return getPath();
 }
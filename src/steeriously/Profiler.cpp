@@ -0,0 +1,237 @@
+#include <atomic>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include <steeriously/Profiler.hpp>
+
+using namespace steer;
+
+namespace
+{
+    //the counters one thread records into - only that thread writes
+    //them, relaxed atomics let endTick read them without a data race
+    struct ThreadSlot
+    {
+        std::atomic<Uint64> calls[profile::phaseCount];
+        std::atomic<Uint64> nanoseconds[profile::phaseCount];
+        std::atomic<Uint64> counters[profile::counterCount];
+
+        ThreadSlot()
+        {
+            for (auto& c : calls) c.store(0, std::memory_order_relaxed);
+            for (auto& n : nanoseconds) n.store(0, std::memory_order_relaxed);
+            for (auto& c : counters) c.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    struct ProfilerState
+    {
+        std::mutex                                  mutex;
+        std::vector< std::unique_ptr<ThreadSlot> >  slots;///< one per thread that ever recorded, kept when the thread ends.
+        ProfileFrame                                previous;///< totals at the end of the tick before the last.
+        ProfileFrame                                last;
+        ProfileFrame                                totals;
+        ProfileFrame                                summaryStart;///< totals when the last summary was written.
+        Uint32                                      summaryInterval = 0;
+        std::ostream*                               summaryOut = nullptr;
+
+        ProfilerState()
+        {
+            previous.clear();
+            last.clear();
+            totals.clear();
+            summaryStart.clear();
+        }
+    };
+
+    ProfilerState& state()
+    {
+        static ProfilerState s;
+        return s;
+    }
+
+    ThreadSlot& threadSlot()
+    {
+        static thread_local ThreadSlot* slot = nullptr;
+
+        if (slot == nullptr)
+        {
+            ProfilerState& s = state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+
+            s.slots.push_back(std::unique_ptr<ThreadSlot>(new ThreadSlot()));
+            slot = s.slots.back().get();
+        }
+
+        return *slot;
+    }
+
+    void difference(const ProfileFrame& a, const ProfileFrame& b, ProfileFrame& result)
+    {
+        for (Uint32 i = 0; i < profile::phaseCount; ++i)
+        {
+            result.calls[i] = a.calls[i] - b.calls[i];
+            result.nanoseconds[i] = a.nanoseconds[i] - b.nanoseconds[i];
+        }
+
+        for (Uint32 i = 0; i < profile::counterCount; ++i)
+            result.counters[i] = a.counters[i] - b.counters[i];
+
+        result.ticks = a.ticks - b.ticks;
+    }
+}
+
+void steer::ProfileFrame::clear()
+{
+    memset(calls, 0, sizeof(calls));
+    memset(nanoseconds, 0, sizeof(nanoseconds));
+    memset(counters, 0, sizeof(counters));
+    ticks = 0;
+}
+
+void steer::Profiler::record(profile::Phase phase, Uint64 nanoseconds)
+{
+    ThreadSlot& slot = threadSlot();
+
+    slot.calls[phase].fetch_add(1, std::memory_order_relaxed);
+    slot.nanoseconds[phase].fetch_add(nanoseconds, std::memory_order_relaxed);
+}
+
+void steer::Profiler::count(profile::Counter counter, Uint64 amount)
+{
+    threadSlot().counters[counter].fetch_add(amount, std::memory_order_relaxed);
+}
+
+void steer::Profiler::endTick()
+{
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    s.previous = s.totals;
+    s.totals.clear();
+    s.totals.ticks = s.previous.ticks + 1;
+
+    //sum what every thread recorded so far
+    for (auto& slot : s.slots)
+    {
+        for (Uint32 i = 0; i < profile::phaseCount; ++i)
+        {
+            s.totals.calls[i] += slot->calls[i].load(std::memory_order_relaxed);
+            s.totals.nanoseconds[i] += slot->nanoseconds[i].load(std::memory_order_relaxed);
+        }
+
+        for (Uint32 i = 0; i < profile::counterCount; ++i)
+            s.totals.counters[i] += slot->counters[i].load(std::memory_order_relaxed);
+    }
+
+    difference(s.totals, s.previous, s.last);
+
+    if (s.summaryInterval != 0 && s.summaryOut != nullptr && s.totals.ticks - s.summaryStart.ticks >= s.summaryInterval)
+    {
+        ProfileFrame window;
+        difference(s.totals, s.summaryStart, window);
+
+        writeSummary(*s.summaryOut, window);
+
+        s.summaryStart = s.totals;
+    }
+}
+
+const ProfileFrame& steer::Profiler::lastTick()
+{
+    return state().last;
+}
+
+const ProfileFrame& steer::Profiler::totals()
+{
+    return state().totals;
+}
+
+void steer::Profiler::reset()
+{
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    for (auto& slot : s.slots)
+    {
+        for (auto& c : slot->calls) c.store(0, std::memory_order_relaxed);
+        for (auto& n : slot->nanoseconds) n.store(0, std::memory_order_relaxed);
+        for (auto& c : slot->counters) c.store(0, std::memory_order_relaxed);
+    }
+
+    s.previous.clear();
+    s.last.clear();
+    s.totals.clear();
+    s.summaryStart.clear();
+}
+
+void steer::Profiler::setSummaryInterval(Uint32 ticks, std::ostream* out)
+{
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    s.summaryInterval = ticks;
+    s.summaryOut = out;
+    s.summaryStart = s.totals;
+}
+
+void steer::Profiler::writeSummary(std::ostream& out, const ProfileFrame& frame)
+{
+    double ticks = frame.ticks > 0 ? (double)frame.ticks : 1.0;
+
+    std::ios::fmtflags flags = out.flags();
+
+    out << "steeriously profile, " << frame.ticks << " ticks, per tick:\n";
+    out << std::left << std::setw(20) << "phase" << std::right << std::setw(14) << "calls" << std::setw(14) << "ms" << std::setw(14) << "ns/call" << "\n";
+    out << std::fixed;
+
+    for (Uint32 i = 0; i < profile::phaseCount; ++i)
+    {
+        if (frame.calls[i] == 0)
+            continue;
+
+        out << std::left << std::setw(20) << name((profile::Phase)i) << std::right
+            << std::setw(14) << std::setprecision(1) << frame.calls[i] / ticks
+            << std::setw(14) << std::setprecision(3) << frame.nanoseconds[i] * 1e-6 / ticks
+            << std::setw(14) << std::setprecision(1) << (double)frame.nanoseconds[i] / (double)frame.calls[i] << "\n";
+    }
+
+    for (Uint32 i = 0; i < profile::counterCount; ++i)
+    {
+        if (frame.counters[i] == 0)
+            continue;
+
+        out << std::left << std::setw(20) << name((profile::Counter)i) << std::right
+            << std::setw(14) << std::setprecision(1) << frame.counters[i] / ticks << "\n";
+    }
+
+    out.flush();
+    out.flags(flags);
+}
+
+const char* steer::Profiler::name(profile::Phase phase)
+{
+    static const char* names[profile::phaseCount] =
+    {
+        "seek", "flee", "arrive", "pursuit", "evade", "offsetPursuit", "interpose", "hide", "wander",
+        "followPath", "separation", "alignment", "cohesion", "flocking", "obstacleAvoidance", "wallAvoidance",
+        "tagNeighbors", "tagObstacles", "calculate", "integrate",
+        "worldIndices", "worldForces", "worldIntegrate", "worldSettle"
+    };
+
+    return phase < profile::phaseCount ? names[phase] : "unknown";
+}
+
+const char* steer::Profiler::name(profile::Counter counter)
+{
+    static const char* names[profile::counterCount] =
+    {
+        "neighborsVisited", "obstaclesTested", "wallsTested"
+    };
+
+    return counter < profile::counterCount ? names[counter] : "unknown";
+}
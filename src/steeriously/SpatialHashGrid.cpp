@@ -0,0 +1,212 @@
+#include <math.h>
+
+#include <steeriously/SpatialHashGrid.hpp>
+#include <steeriously/Agent.hpp>
+#include <steeriously/VectorMath.hpp>
+
+using namespace steer;
+
+namespace
+{
+    Uint32 nextPowerOfTwo(Uint32 value)
+    {
+        Uint32 result = 1;
+
+        while (result < value)
+            result <<= 1;
+
+        return result;
+    }
+}
+
+steer::SpatialHashGrid::SpatialHashGrid(float cellSize, Uint32 numBuckets)
+: m_buckets(nextPowerOfTwo(numBuckets))
+, m_cellSize(cellSize)
+, m_inverseCellSize(1.f / cellSize)
+, m_bucketMask(nextPowerOfTwo(numBuckets) - 1)
+, m_numEntities(0)
+, m_maxEntityRadius(0.f)
+{
+    assert(cellSize > 0.f && "<SpatialHashGrid> cell size must be positive");
+}
+
+steer::SpatialHashGrid::SpatialHashGrid(const BehaviorParameters& params, Uint32 numBuckets)
+: SpatialHashGrid(MaxOf(params.ViewDistance, params.neighborhoodRadius) + params.radius, numBuckets)
+{
+
+}
+
+steer::SpatialHashGrid::~SpatialHashGrid()
+{
+
+}
+
+Int32 steer::SpatialHashGrid::cellCoord(double value) const
+{
+    return (Int32)floor(value * m_inverseCellSize);
+}
+
+Uint32 steer::SpatialHashGrid::bucketIndex(Int32 cellX, Int32 cellY) const
+{
+    return (((Uint32)cellX * 73856093u) ^ ((Uint32)cellY * 19349663u)) & m_bucketMask;
+}
+
+void steer::SpatialHashGrid::insert(Agent* agent, Int32 cellX, Int32 cellY)
+{
+    Entry entry = { agent, cellX, cellY };
+
+    m_buckets[bucketIndex(cellX, cellY)].push_back(entry);
+}
+
+bool steer::SpatialHashGrid::remove(Agent* agent, Int32 cellX, Int32 cellY)
+{
+    std::vector<Entry>& bucket = m_buckets[bucketIndex(cellX, cellY)];
+
+    for (unsigned int i = 0; i < bucket.size(); ++i)
+    {
+        if (bucket[i].agent == agent)
+        {
+            //order within a bucket does not matter, swap and pop
+            bucket[i] = bucket.back();
+            bucket.pop_back();
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void steer::SpatialHashGrid::registerEntity(Agent* agent)
+{
+    assert(agent != nullptr);
+
+    Vector2 position = agent->getPublishedPosition();
+
+    insert(agent, cellCoord(position.x), cellCoord(position.y));
+
+    m_maxEntityRadius = MaxOf(m_maxEntityRadius, agent->getBoundingRadius());
+
+    ++m_numEntities;
+}
+
+void steer::SpatialHashGrid::unregisterEntity(Agent* agent)
+{
+    Vector2 position = agent->getPublishedPosition();
+
+    bool found = remove(agent, cellCoord(position.x), cellCoord(position.y));
+
+    //the agent was moved without the grid being told, search every bucket
+    for (unsigned int b = 0; !found && b < m_buckets.size(); ++b)
+    {
+        std::vector<Entry>& bucket = m_buckets[b];
+
+        for (unsigned int i = 0; i < bucket.size(); ++i)
+        {
+            if (bucket[i].agent == agent)
+            {
+                bucket[i] = bucket.back();
+                bucket.pop_back();
+
+                found = true;
+                break;
+            }
+        }
+    }
+
+    if (found)
+        --m_numEntities;
+}
+
+void steer::SpatialHashGrid::updateEntity(Agent* agent, Vector2 oldPosition)
+{
+    Vector2 position = agent->getPublishedPosition();
+
+    Int32 oldX = cellCoord(oldPosition.x);
+    Int32 oldY = cellCoord(oldPosition.y);
+    Int32 newX = cellCoord(position.x);
+    Int32 newY = cellCoord(position.y);
+
+    //most agents stay within their cell from one frame to the next
+    if (oldX == newX && oldY == newY)
+        return;
+
+    if (remove(agent, oldX, oldY))
+    {
+        insert(agent, newX, newY);
+    }
+    else
+    {
+        //the old position was not the one the agent was binned at,
+        //fall back to a full removal
+        unregisterEntity(agent);
+        registerEntity(agent);
+    }
+}
+
+void steer::SpatialHashGrid::rebuild()
+{
+    std::vector<Agent*> agents;
+    agents.reserve(m_numEntities);
+
+    for (auto& bucket : m_buckets)
+    {
+        for (auto& entry : bucket)
+            agents.push_back(entry.agent);
+
+        bucket.clear();
+    }
+
+    m_numEntities = 0;
+    m_maxEntityRadius = 0.f;
+
+    for (auto& agent : agents)
+        registerEntity(agent);
+}
+
+void steer::SpatialHashGrid::clear()
+{
+    for (auto& bucket : m_buckets)
+        bucket.clear();
+
+    m_numEntities = 0;
+    m_maxEntityRadius = 0.f;
+}
+
+void steer::SpatialHashGrid::query(Vector2 position, float radius, std::vector<Agent*>& result, const Agent* exclude) const
+{
+    //widen the search by the largest bounding radius so agents whose
+    //centers lie in the next cell over are not missed
+    float reach = radius + m_maxEntityRadius;
+
+    Int32 minX = cellCoord(position.x - reach);
+    Int32 maxX = cellCoord(position.x + reach);
+    Int32 minY = cellCoord(position.y - reach);
+    Int32 maxY = cellCoord(position.y + reach);
+
+    for (Int32 y = minY; y <= maxY; ++y)
+    {
+        for (Int32 x = minX; x <= maxX; ++x)
+        {
+            const std::vector<Entry>& bucket = m_buckets[bucketIndex(x, y)];
+
+            for (auto& entry : bucket)
+            {
+                //skip entries from other cells hashed into the same bucket
+                if (entry.cellX != x || entry.cellY != y || entry.agent == exclude)
+                    continue;
+
+                Vector2 to = entry.agent->getPublishedPosition() - position;
+
+                //the bounding radius of the other is taken into account by adding it
+                //to the range
+                float range = radius + entry.agent->getBoundingRadius();
+
+                if (VectorMath::lengthSquared(to) < range*range)
+                {
+                    result.push_back(entry.agent);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,161 @@
+#include <steeriously/ThreadPool.hpp>
+
+using namespace steer;
+
+steer::ThreadPool::ThreadPool(Uint32 threadCount)
+: m_job(nullptr)
+, m_pending(0)
+, m_generation(0)
+, m_quit(false)
+{
+    if (threadCount == 0)
+        threadCount = std::thread::hardware_concurrency();
+
+    if (threadCount == 0)
+        threadCount = 1;
+
+    for (Uint32 i = 0; i < threadCount; ++i)
+        m_queues.push_back(std::unique_ptr<Queue>(new Queue()));
+
+    //the calling thread works too, it owns the last queue
+    for (Uint32 i = 0; i + 1 < threadCount; ++i)
+        m_threads.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+}
+
+steer::ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+
+    m_wake.notify_all();
+
+    for (auto& thread : m_threads)
+        thread.join();
+}
+
+void steer::ThreadPool::parallelFor(Uint32 count, Uint32 grain, const std::function<void(Uint32, Uint32)>& job)
+{
+    if (count == 0)
+        return;
+
+    if (grain == 0)
+        grain = 1;
+
+    //not worth waking anybody up
+    if (m_threads.empty() || count <= grain)
+    {
+        job(0, count);
+        return;
+    }
+
+    m_job = &job;
+    m_pending = (count + grain - 1) / grain;
+
+    //deal the chunks out round robin so every thread starts with
+    //a share of the loop
+    Uint32 numQueues = (Uint32)m_queues.size();
+    Uint32 chunk = 0;
+
+    for (Uint32 begin = 0; begin < count; begin += grain, ++chunk)
+    {
+        Range range = { begin, MinOf(begin + grain, count) };
+
+        Queue& queue = *m_queues[chunk % numQueues];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.ranges.push_back(range);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_generation;
+    }
+
+    m_wake.notify_all();
+
+    //help out until there is nothing left to take...
+    while (runOne(numQueues - 1))
+    {
+    }
+
+    //...then wait for the chunks other threads are still running
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this]() { return m_pending == 0; });
+
+    m_job = nullptr;
+}
+
+void steer::ThreadPool::workerLoop(Uint32 index)
+{
+    Uint64 generation = 0;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&]() { return m_quit || m_generation != generation; });
+
+            if (m_quit)
+                return;
+
+            generation = m_generation;
+        }
+
+        while (runOne(index))
+        {
+        }
+    }
+}
+
+bool steer::ThreadPool::runOne(Uint32 index)
+{
+    Uint32 numQueues = (Uint32)m_queues.size();
+    Range range;
+    bool found = false;
+
+    //own queue first, front to back
+    {
+        Queue& queue = *m_queues[index];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.ranges.empty())
+        {
+            range = queue.ranges.front();
+            queue.ranges.pop_front();
+            found = true;
+        }
+    }
+
+    //then steal from the back of the others
+    for (Uint32 i = 1; !found && i < numQueues; ++i)
+    {
+        Queue& queue = *m_queues[(index + i) % numQueues];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.ranges.empty())
+        {
+            range = queue.ranges.back();
+            queue.ranges.pop_back();
+            found = true;
+        }
+    }
+
+    if (!found)
+        return false;
+
+    (*m_job)(range.begin, range.end);
+
+    if (--m_pending == 0)
+    {
+        //take the lock so the wake up cannot slip in between the
+        //calling thread checking the count and going to sleep
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_done.notify_all();
+    }
+
+    return true;
+}
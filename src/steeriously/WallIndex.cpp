@@ -0,0 +1,239 @@
+#include <math.h>
+
+#include <steeriously/WallIndex.hpp>
+#include <steeriously/GeometryHelpers.hpp>
+#include <steeriously/Profiler.hpp>
+#include <steeriously/VectorMath.hpp>
+
+using namespace steer;
+
+namespace
+{
+    //keeps a careless cell size from allocating the whole machine
+    const Int32 MaxCells = 1 << 22;
+
+    //true when the segment a-b crosses the box, given that it
+    //overlaps the bounds of the box - it does unless all four
+    //corners are strictly on the same side of the line
+    bool segmentCrossesBox(float ax, float ay, float bx, float by, float minX, float minY, float maxX, float maxY)
+    {
+        float nx = ay - by;
+        float ny = bx - ax;
+
+        float d0 = nx * (minX - ax) + ny * (minY - ay);
+        float d1 = nx * (maxX - ax) + ny * (minY - ay);
+        float d2 = nx * (minX - ax) + ny * (maxY - ay);
+        float d3 = nx * (maxX - ax) + ny * (maxY - ay);
+
+        bool allAbove = d0 > 0.f && d1 > 0.f && d2 > 0.f && d3 > 0.f;
+        bool allBelow = d0 < 0.f && d1 < 0.f && d2 < 0.f && d3 < 0.f;
+
+        return !(allAbove || allBelow);
+    }
+}
+
+steer::WallIndex::WallIndex()
+: m_originX(0.f)
+, m_originY(0.f)
+, m_cellSize(1.f)
+, m_inverseCellSize(1.f)
+, m_numCellsX(0)
+, m_numCellsY(0)
+{
+}
+
+steer::WallIndex::WallIndex(const std::vector<steer::Wall*>& walls, float cellSize)
+: WallIndex()
+{
+    build(walls, cellSize);
+}
+
+Int32 steer::WallIndex::cellCoord(float value, float origin, Int32 numCells) const
+{
+    Int32 cell = (Int32)floorf((value - origin) * m_inverseCellSize);
+
+    return MaxOf(0, MinOf(cell, numCells - 1));
+}
+
+void steer::WallIndex::build(const std::vector<steer::Wall*>& walls, float cellSize)
+{
+    m_walls.clear();
+    m_cellStart.clear();
+    m_fromX.clear();
+    m_fromY.clear();
+    m_toX.clear();
+    m_toY.clear();
+    m_wallIndex.clear();
+    m_numCellsX = 0;
+    m_numCellsY = 0;
+
+    float minX = MaxFloat, minY = MaxFloat;
+    float maxX = -MaxFloat, maxY = -MaxFloat;
+
+    for (auto& w : walls)
+    {
+        if (w == nullptr)
+            continue;
+
+        m_walls.push_back(w);
+
+        minX = MinOf(minX, (float)MinOf(w->From().x, w->To().x));
+        minY = MinOf(minY, (float)MinOf(w->From().y, w->To().y));
+        maxX = MaxOf(maxX, (float)MaxOf(w->From().x, w->To().x));
+        maxY = MaxOf(maxY, (float)MaxOf(w->From().y, w->To().y));
+    }
+
+    if (m_walls.empty())
+        return;
+
+    float extent = MaxOf(maxX - minX, maxY - minY);
+
+    //about one wall per cell when the walls are spread evenly
+    if (cellSize <= 0.f)
+        cellSize = extent / ceilf(sqrtf((float)m_walls.size()));
+
+    if (cellSize <= 0.f)
+        cellSize = 1.f;
+
+    while ((Int64)((maxX - minX) / cellSize + 1) * (Int64)((maxY - minY) / cellSize + 1) > MaxCells)
+        cellSize *= 2.f;
+
+    m_cellSize = cellSize;
+    m_inverseCellSize = 1.f / cellSize;
+    m_originX = minX;
+    m_originY = minY;
+    m_numCellsX = (Int32)((maxX - minX) * m_inverseCellSize) + 1;
+    m_numCellsY = (Int32)((maxY - minY) * m_inverseCellSize) + 1;
+
+    Uint32 numCells = (Uint32)(m_numCellsX * m_numCellsY);
+
+    //two passes over the walls - count the segments of each cell, then
+    //turn the counts into offsets and drop each segment into its run
+    std::vector<Uint32> counts(numCells + 1, 0);
+
+    for (Uint32 pass = 0; pass < 2; ++pass)
+    {
+        for (Uint32 i = 0; i < (Uint32)m_walls.size(); ++i)
+        {
+            float ax = (float)m_walls[i]->From().x, ay = (float)m_walls[i]->From().y;
+            float bx = (float)m_walls[i]->To().x, by = (float)m_walls[i]->To().y;
+
+            Int32 x0 = cellCoord(MinOf(ax, bx), m_originX, m_numCellsX);
+            Int32 x1 = cellCoord(MaxOf(ax, bx), m_originX, m_numCellsX);
+            Int32 y0 = cellCoord(MinOf(ay, by), m_originY, m_numCellsY);
+            Int32 y1 = cellCoord(MaxOf(ay, by), m_originY, m_numCellsY);
+
+            for (Int32 y = y0; y <= y1; ++y)
+            {
+                for (Int32 x = x0; x <= x1; ++x)
+                {
+                    float cellMinX = m_originX + x * m_cellSize;
+                    float cellMinY = m_originY + y * m_cellSize;
+
+                    if (!segmentCrossesBox(ax, ay, bx, by, cellMinX, cellMinY, cellMinX + m_cellSize, cellMinY + m_cellSize))
+                        continue;
+
+                    Uint32 cell = (Uint32)(y * m_numCellsX + x);
+
+                    if (pass == 0)
+                    {
+                        ++counts[cell + 1];
+                    }
+                    else
+                    {
+                        Uint32 slot = counts[cell]++;
+
+                        m_fromX[slot] = ax;
+                        m_fromY[slot] = ay;
+                        m_toX[slot] = bx;
+                        m_toY[slot] = by;
+                        m_wallIndex[slot] = i;
+                    }
+                }
+            }
+        }
+
+        if (pass == 0)
+        {
+            for (Uint32 c = 0; c < numCells; ++c)
+                counts[c + 1] += counts[c];
+
+            m_cellStart = counts;
+
+            Uint32 numSegments = counts[numCells];
+
+            m_fromX.resize(numSegments);
+            m_fromY.resize(numSegments);
+            m_toX.resize(numSegments);
+            m_toY.resize(numSegments);
+            m_wallIndex.resize(numSegments);
+        }
+    }
+}
+
+bool steer::WallIndex::intersectRay(steer::Vector2 from, steer::Vector2 to, steer::WallHit& hit) const
+{
+    if (m_walls.empty())
+        return false;
+
+    float ax = (float)from.x, ay = (float)from.y;
+    float bx = (float)to.x, by = (float)to.y;
+
+    //the ray misses the grid entirely
+    if (MaxOf(ax, bx) < m_originX || MinOf(ax, bx) > m_originX + m_numCellsX * m_cellSize ||
+        MaxOf(ay, by) < m_originY || MinOf(ay, by) > m_originY + m_numCellsY * m_cellSize)
+    {
+        return false;
+    }
+
+    Int32 x0 = cellCoord(MinOf(ax, bx), m_originX, m_numCellsX);
+    Int32 x1 = cellCoord(MaxOf(ax, bx), m_originX, m_numCellsX);
+    Int32 y0 = cellCoord(MinOf(ay, by), m_originY, m_numCellsY);
+    Int32 y1 = cellCoord(MaxOf(ay, by), m_originY, m_numCellsY);
+
+    //walls are compared by how far along the ray they are hit
+    float bestR = MaxFloat;
+    Uint32 best = 0;
+    bool found = false;
+
+    for (Int32 y = y0; y <= y1; ++y)
+    {
+        for (Int32 x = x0; x <= x1; ++x)
+        {
+            Uint32 cell = (Uint32)(y * m_numCellsX + x);
+            Uint32 begin = m_cellStart[cell];
+
+            STEERIOUSLY_PROFILE_COUNT(steer::profile::wallsTested, m_cellStart[cell + 1] - begin);
+
+            //the segments of a cell are in wall order, so the kernel
+            //already prefers the first wall of the cell on a tie. A segment
+            //crossing several cells is found once per cell, which does not
+            //change which one is nearest
+            steer::RayHit cellHit;
+
+            if (!steer::RaySegmentsIntersection(from, to, m_fromX.data() + begin, m_fromY.data() + begin, m_toX.data() + begin, m_toY.data() + begin,
+                                                m_cellStart[cell + 1] - begin, cellHit))
+            {
+                continue;
+            }
+
+            Uint32 wall = m_wallIndex[begin + cellHit.index];
+
+            if (cellHit.t < bestR || (cellHit.t == bestR && wall < best))
+            {
+                bestR = cellHit.t;
+                best = wall;
+                found = true;
+            }
+        }
+    }
+
+    if (!found)
+        return false;
+
+    hit.wall = m_walls[best];
+    hit.distance = steer::VectorMath::distance(from, to) * bestR;
+    hit.point = from + bestR * (to - from);
+
+    return true;
+}
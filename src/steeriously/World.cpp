@@ -0,0 +1,587 @@
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+#include <steeriously/World.hpp>
+#include <steeriously/BehaviorHelpers.hpp>
+#include <steeriously/Profiler.hpp>
+#include <steeriously/components/SuperComponent.hpp>
+
+using namespace steer;
+
+namespace
+{
+    //objects created by the world go back to its pool, objects
+    //handed to it with add were allocated with new
+    template <class T>
+    void release(ObjectPool<T>& pool, T* object)
+    {
+        if (pool.owns(object))
+            pool.destroy(object);
+        else
+            delete object;
+    }
+
+    const Uint32 noIndex = ~(Uint32)0;
+
+    //swap the agent in a registry slot with the last one of a list and
+    //pop it, the positions of the agents are kept by slot
+    void eraseAgent(std::vector<SuperComponent*>& agents, std::vector<Uint32>& positions, Uint32 slot)
+    {
+        Uint32 position = positions[slot];
+        SuperComponent* last = agents.back();
+
+        agents[position] = last;
+        positions[last->getHandle().index] = position;
+
+        agents.pop_back();
+        positions[slot] = noIndex;
+    }
+}
+
+steer::World::World(BehaviorParameters* params)
+: m_params(params)
+, m_cellSpace(*params)
+, m_pool(nullptr)
+, m_lodScheduler(nullptr)
+, m_tick(0)
+, m_archetypesChanged(false)
+, m_awakeChanged(false)
+, m_bindTargets(false)
+, m_rebuildIndex(false)
+, m_rebuildObstacles(false)
+, m_rebuildWalls(false)
+{
+
+}
+
+steer::World::~World()
+{
+    //agents go first, they unregister from the spatial index on destruction
+    for (auto& agent : m_agents)
+        release(m_agentPool, agent);
+
+    for (auto& obstacle : m_obstacles)
+        release(m_obstaclePool, obstacle);
+
+    for (auto& wall : m_walls)
+        release(m_wallPool, wall);
+
+    DeleteSTLContainer(m_paths);
+
+    delete m_pool;
+}
+
+SuperComponent* steer::World::createAgent()
+{
+    return createAgent(m_params);
+}
+
+SuperComponent* steer::World::createAgent(BehaviorParameters* params)
+{
+    SuperComponent* agent = m_agentPool.create(params);
+
+    addAgent(agent);
+
+    return agent;
+}
+
+void steer::World::addAgent(SuperComponent* agent)
+{
+    assert(agent != nullptr);
+
+    agent->setNeighbors(&m_agents);
+    agent->setObstacles(&m_obstacles);
+    agent->setObstacleIndex(&m_obstacleIndex);
+    agent->setWalls(&m_walls);
+    agent->setWallIndex(&m_wallIndex);
+    agent->setCellSpace(&m_cellSpace);
+    agent->setWakeFlag(&m_awakeChanged);
+    agent->setArchetypeFlag(&m_archetypesChanged);
+    AgentHandle handle = m_registry.add(agent);
+
+    agent->setRegistry(&m_registry, handle);
+
+    if (handle.index >= m_agentIndex.size())
+    {
+        m_agentIndex.resize(handle.index + 1, noIndex);
+        m_awakeIndex.resize(handle.index + 1, noIndex);
+    }
+
+    m_agentIndex[handle.index] = (Uint32)m_agents.size();
+    m_agents.push_back(agent);
+
+    if (!agent->isAsleep())
+    {
+        m_awakeIndex[handle.index] = (Uint32)m_awake.size();
+        m_awake.push_back(agent);
+        m_archetypesChanged = true;
+    }
+
+    //targets set to the agent before it joined only pick up its handle
+    //once bound
+    m_bindTargets = true;
+}
+
+void steer::World::removeAgent(SuperComponent* agent)
+{
+    AgentHandle handle = agent->getHandle();
+
+    if (m_registry.resolve(handle) != agent)
+        return;
+
+    //agents steering relative to the removed agent hold its handle,
+    //which goes stale below and resolves to null - nobody is scanned
+    eraseAgent(m_agents, m_agentIndex, handle.index);
+
+    if (m_awakeIndex[handle.index] != noIndex)
+        eraseAgent(m_awake, m_awakeIndex, handle.index);
+
+    m_archetypesChanged = true;
+
+    m_registry.remove(handle);
+    agent->setRegistry(nullptr, AgentHandle());
+
+    release(m_agentPool, agent);
+}
+
+SuperComponent* steer::World::getAgent(AgentHandle handle) const
+{
+    //only agents of the world are registered with m_registry
+    return static_cast<SuperComponent*>(m_registry.resolve(handle));
+}
+
+void steer::World::defragment()
+{
+    //targets must follow their agent by handle before anybody moves
+    bindTargets();
+
+    //row by row of cells, agents keep their order within a cell. The
+    //sign bit is flipped so negative cells sort before positive ones
+    float inverseCellSize = 1.f / m_cellSpace.getCellSize();
+    std::vector< std::pair<Uint64, SuperComponent*> > keyed;
+
+    keyed.reserve(m_agents.size());
+
+    for (auto& agent : m_agents)
+    {
+        Uint32 cellX = (Uint32)(Int32)std::floor(agent->getPosition().x * inverseCellSize) ^ 0x80000000u;
+        Uint32 cellY = (Uint32)(Int32)std::floor(agent->getPosition().y * inverseCellSize) ^ 0x80000000u;
+
+        keyed.push_back(std::make_pair(((Uint64)cellY << 32) | cellX, agent));
+    }
+
+    std::stable_sort(keyed.begin(), keyed.end(), [](const std::pair<Uint64, SuperComponent*>& a, const std::pair<Uint64, SuperComponent*>& b)
+    {
+        return a.first < b.first;
+    });
+
+    //copy the agents into a fresh pool in that order, agents added with
+    //addAgent were allocated with new and stay where they are
+    ObjectPool<SuperComponent> pool;
+
+    pool.reserve(m_agentPool.size());
+
+    for (std::size_t i = 0; i < keyed.size(); ++i)
+    {
+        SuperComponent* agent = keyed[i].second;
+
+        if (m_agentPool.owns(agent))
+        {
+            agent->setCellSpace(nullptr);
+
+            SuperComponent* moved = pool.create(*agent);
+
+            m_agentPool.destroy(agent);
+            m_registry.relocate(moved->getHandle(), moved);
+            moved->setCellSpace(&m_cellSpace);
+
+            agent = moved;
+        }
+
+        //the neighbors gathered on the last step may sit in the old pool,
+        //which is freed below - the next step gathers them again
+        agent->m_neighborhood.clear();
+
+        m_agents[i] = agent;
+        m_agentIndex[agent->getHandle().index] = (Uint32)i;
+    }
+
+    m_agentPool.swap(pool);
+
+    //the awake list and archetype table point at the old addresses
+    refreshAwake();
+    m_archetypesChanged = true;
+}
+
+SphereObstacle* steer::World::createObstacle(Vector2 position, float radius)
+{
+    SphereObstacle* obstacle = m_obstaclePool.create(position, radius);
+
+    addObstacle(obstacle);
+
+    return obstacle;
+}
+
+void steer::World::addObstacle(SphereObstacle* obstacle)
+{
+    assert(obstacle != nullptr);
+
+    m_obstacles.push_back(obstacle);
+
+    m_rebuildObstacles = true;
+}
+
+void steer::World::removeObstacle(SphereObstacle* obstacle)
+{
+    auto it = std::find(m_obstacles.begin(), m_obstacles.end(), obstacle);
+
+    if (it == m_obstacles.end())
+        return;
+
+    m_obstacles.erase(it);
+
+    //rebuild right away, the index must not hand out the deleted obstacle
+    m_obstacleIndex.build(m_obstacles);
+    m_rebuildObstacles = false;
+
+    release(m_obstaclePool, obstacle);
+}
+
+Wall* steer::World::createWall(Vector2 from, Vector2 to)
+{
+    Wall* wall = m_wallPool.create(false, from, to);
+
+    addWall(wall);
+
+    return wall;
+}
+
+void steer::World::addWall(Wall* wall)
+{
+    assert(wall != nullptr);
+
+    m_walls.push_back(wall);
+
+    m_rebuildWalls = true;
+}
+
+void steer::World::removeWall(Wall* wall)
+{
+    auto it = std::find(m_walls.begin(), m_walls.end(), wall);
+
+    if (it == m_walls.end())
+        return;
+
+    m_walls.erase(it);
+
+    //rebuild right away, the index must not hand out the deleted wall
+    m_wallIndex.build(m_walls);
+    m_rebuildWalls = false;
+
+    release(m_wallPool, wall);
+}
+
+Path* steer::World::createPath(std::list<Vector2>& waypoints)
+{
+    Path* path = new Path((int)waypoints.size(), waypoints);
+
+    addPath(path);
+
+    return path;
+}
+
+Path* steer::World::createPath(const std::vector<Vector2>& waypoints)
+{
+    Path* path = new Path(waypoints);
+
+    addPath(path);
+
+    return path;
+}
+
+void steer::World::addPath(Path* path)
+{
+    assert(path != nullptr);
+
+    m_paths.push_back(path);
+}
+
+void steer::World::removePath(Path* path)
+{
+    auto it = std::find(m_paths.begin(), m_paths.end(), path);
+
+    if (it == m_paths.end())
+        return;
+
+    m_paths.erase(it);
+
+    for (auto& a : m_agents)
+    {
+        if (a->getPath() == path)
+            a->setPath(nullptr);
+
+        if (a->getPathCursor().getData() == path->getData())
+            a->setPathData(nullptr);
+    }
+
+    delete path;
+}
+
+void steer::World::reserve(Uint32 agents, Uint32 obstacles, Uint32 walls)
+{
+    m_agentPool.reserve(agents);
+    m_agents.reserve(agents);
+    m_awake.reserve(agents);
+
+    m_obstaclePool.reserve(obstacles);
+    m_obstacles.reserve(obstacles);
+
+    m_wallPool.reserve(walls);
+    m_walls.reserve(walls);
+}
+
+void steer::World::setThreadCount(Uint32 count)
+{
+    delete m_pool;
+    m_pool = nullptr;
+
+    if (count != 1)
+        m_pool = new ThreadPool(count);
+}
+
+Uint32 steer::World::getThreadCount() const
+{
+    return m_pool != nullptr ? m_pool->getThreadCount() : 1;
+}
+
+void steer::World::parallelFor(Uint32 count, Uint32 grain, const std::function<void(Uint32, Uint32)>& job)
+{
+    if (m_pool != nullptr)
+        m_pool->parallelFor(count, grain, job);
+    else
+        job(0, count);
+}
+
+void steer::World::step(float dt)
+{
+    //stage one: the spatial index is kept up to date incrementally
+    //as agents move, only rebuild it when asked to
+    {
+        STEERIOUSLY_PROFILE_SCOPE(steer::profile::worldIndices);
+
+        if (m_rebuildIndex)
+        {
+            m_cellSpace.rebuild();
+            m_rebuildIndex = false;
+        }
+
+        //obstacles and walls are static, their indices are only rebuilt when they change
+        if (m_rebuildObstacles)
+        {
+            m_obstacleIndex.build(m_obstacles);
+            m_rebuildObstacles = false;
+        }
+
+        if (m_rebuildWalls)
+        {
+            m_wallIndex.build(m_walls);
+            m_rebuildWalls = false;
+        }
+
+        if (m_bindTargets)
+            bindTargets();
+
+        if (m_awakeChanged)
+        {
+            refreshAwake();
+            m_archetypesChanged = true;
+        }
+
+        //agents are bucketed by their behaviors, only rebuild the
+        //buckets when somebody's behaviors changed
+        if (m_archetypesChanged)
+        {
+            m_archetypes.rebuild(m_awake);
+            m_archetypesChanged = false;
+        }
+    }
+
+    //stage two: compute the steering force of every agent. Agents of
+    //the world gather their neighbors from the spatial index without
+    //tagging anybody, so each agent only writes to itself and nobody
+    //moves until every force is known. Each agent's random stream is
+    //keyed by its id and the tick, so what it draws does not depend on
+    //which thread runs it. Sleeping agents are left out of every stage.
+    //Agents are visited in runs of the same archetype, so a run of agents
+    //all go through the same kernel
+    Uint32 count = (Uint32)m_awake.size();
+    Uint64 tick = m_tick++;
+
+    {
+        STEERIOUSLY_PROFILE_SCOPE(steer::profile::worldForces);
+
+        parallelFor(count, 64, [this, dt, tick](Uint32 begin, Uint32 end)
+        {
+            const std::vector<SuperComponent*>& agents = m_archetypes.getAgents();
+            const std::vector<Archetype>& archetypes = m_archetypes.getArchetypes();
+            const std::vector<ArchetypeRun>& runs = m_archetypes.getRuns();
+            Uint32 r = m_archetypes.runOf(begin);
+
+            for (Uint32 i = begin; i < end; ++i)
+            {
+                while (i >= runs[r].end)
+                    ++r;
+
+                agents[i]->setTick(tick);
+                agents[i]->m_timeElapsed = dt;
+
+                //agents the scheduler skips integrate with their last force
+                if (m_lodScheduler != nullptr && !m_lodScheduler->isDue(*agents[i], tick))
+                    continue;
+
+                ArchetypeTable::calculate(archetypes[runs[r].archetype], *agents[i]);
+            }
+        });
+    }
+
+    //stage three: integrate every agent in one pass over contiguous
+    //arrays, then write the results back and re-bin the agents - only
+    //the re-binning touches shared cells and runs on this thread
+    {
+        STEERIOUSLY_PROFILE_SCOPE(steer::profile::worldIntegrate);
+
+        m_store.resize(count);
+
+        parallelFor(count, 4096, [this, dt](Uint32 begin, Uint32 end)
+        {
+            m_store.load(m_awake, begin, end);
+            m_store.integrate(begin, end, dt);
+            m_store.store(m_awake, begin, end);
+        });
+
+        m_store.place(m_awake);
+    }
+
+    //stage four: agents at rest fall asleep and moving agents wake up
+    //the sleepers around them
+    settle(dt);
+
+    //double-buffered agents only show their new state to the
+    //others once it is published
+    PublishStates(m_awake);
+
+    STEERIOUSLY_PROFILE_TICK();
+}
+
+void steer::World::refreshAwake()
+{
+    m_awake.clear();
+
+    for (auto& agent : m_agents)
+    {
+        Uint32& position = m_awakeIndex[agent->getHandle().index];
+
+        position = noIndex;
+
+        if (!agent->isAsleep())
+        {
+            position = (Uint32)m_awake.size();
+            m_awake.push_back(agent);
+        }
+    }
+
+    m_awakeChanged = false;
+}
+
+void steer::World::bindTargets()
+{
+    for (auto& agent : m_agents)
+        agent->bindTargets();
+
+    m_bindTargets = false;
+}
+
+void steer::World::settle(float dt)
+{
+    STEERIOUSLY_PROFILE_SCOPE(steer::profile::worldSettle);
+
+    Uint32 count = (Uint32)m_awake.size();
+    std::mutex mutex;
+
+    parallelFor(count, 256, [this, dt, &mutex](Uint32 begin, Uint32 end)
+    {
+        bool fellAsleep = false;
+
+        for (Uint32 i = begin; i < end; ++i)
+            fellAsleep |= m_awake[i]->updateRest(dt);
+
+        if (fellAsleep)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            m_awakeChanged = true;
+        }
+    });
+
+    //nobody to wake up
+    if (!m_awakeChanged && count == m_agents.size())
+        return;
+
+    //a sleeper wakes up when an agent moving faster than it may sleep
+    //comes within view. The sleepers are only gathered here, waking
+    //them writes the flag every agent shares
+    std::vector<Agent*> sleepers;
+
+    parallelFor(count, 64, [this, &mutex, &sleepers](Uint32 begin, Uint32 end)
+    {
+        std::vector<Agent*> nearby;
+        std::vector<Agent*> found;
+
+        for (Uint32 i = begin; i < end; ++i)
+        {
+            SuperComponent* agent = m_awake[i];
+
+            if (agent->isAsleep() || VectorMath::lengthSquared(agent->m_velocity) <= agent->m_sleepSpeed * agent->m_sleepSpeed)
+                continue;
+
+            nearby.clear();
+            m_cellSpace.query(agent->getPosition(), agent->m_viewDistance, nearby, agent);
+
+            for (auto& other : nearby)
+            {
+                if (other->isAsleep())
+                    found.push_back(other);
+            }
+        }
+
+        if (!found.empty())
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            sleepers.insert(sleepers.end(), found.begin(), found.end());
+        }
+    });
+
+    //a sleeper also wakes up when an agent it steers by starts moving,
+    //wherever that agent is
+    parallelFor((Uint32)m_agents.size(), 256, [this, &mutex, &sleepers](Uint32 begin, Uint32 end)
+    {
+        std::vector<Agent*> found;
+
+        for (Uint32 i = begin; i < end; ++i)
+        {
+            SuperComponent* agent = m_agents[i];
+
+            if (agent->isAsleep() && agent->hasMovingTarget())
+                found.push_back(agent);
+        }
+
+        if (!found.empty())
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            sleepers.insert(sleepers.end(), found.begin(), found.end());
+        }
+    });
+
+    for (auto& sleeper : sleepers)
+        sleeper->wake();
+}
@@ -14,16 +14,17 @@ steer::FlockingComponent::FlockingComponent(steer::BehaviorParameters* params)
 	, m_weightObstacleAvoidance(params->ObstacleAvoidanceWeight)
 	, m_weightWallAvoidance(params->WallAvoidanceWeight)
 	, m_iFlags()
-	, m_rotation(0.f)
 	, m_neighbors(nullptr)
 	, m_obstacles(nullptr)
+	, m_obstacleIndex(nullptr)
 	, m_walls(nullptr)
+	, m_wallIndex(nullptr)
 	, m_params(params)
 {
     flockingOn();
 
     //stuff for the wander behavior
-	float theta = RandFloat() * TwoPi;
+	float theta = m_random.nextFloat() * TwoPi;
 
 	//create a vector to a target position on the wander circle
 	m_wanderTarget = Vector2(m_wanderRadius * cos(theta), m_wanderRadius * sin(theta));
@@ -39,33 +40,80 @@ Vector2 steer::FlockingComponent::Calculate()
     //reset the steering force
     m_steeringForce = steer::Vector2(0.0, 0.0);
 
-	if(on(steer::behaviorType::alignment) && on(steer::behaviorType::separation) && on(steer::behaviorType::cohesion))
-    {
-        //tag neighbors...
-        TagVehiclesWithinViewRange(this, *m_neighbors, this->m_viewDistance);
-    }
+    //the prioritized and dithered sums gather neighbors themselves,
+    //and only once a flocking behavior actually gets evaluated - until
+    //then the list from the last tick must not be read
+    if (m_summingMethod != steer::summingMethod::weightedSum)
+        m_neighborhood.clear();
 
     //calculate the force, Luke ;)
-	m_steeringForce = calculateWeightedSum();
+    switch (m_summingMethod)
+    {
+    case steer::summingMethod::prioritized:
+        m_steeringForce = calculatePrioritized();
+        break;
+
+    case steer::summingMethod::dithered:
+        m_steeringForce = calculateDithered();
+        break;
+
+    default:
+        tagNeighbors();
+
+        m_steeringForce = calculateWeightedSum();
+        break;
+    }
 
 	return m_steeringForce;
 }
 
+void steer::FlockingComponent::tagNeighbors()
+{
+	if(on(steer::behaviorType::alignment) || on(steer::behaviorType::separation) || on(steer::behaviorType::cohesion))
+    {
+        //gather the neighbors from the surrounding cells when a cell
+        //space partition is available, otherwise in a scan over every
+        //agent - either way no other agent is written to
+        if (m_cellSpace != nullptr)
+            GatherVehiclesWithinViewRange(this, *m_cellSpace, this->m_viewDistance, m_neighborhood);
+        else
+            GatherVehiclesWithinViewRange(this, *m_neighbors, this->m_viewDistance, m_neighborhood);
+    }
+    else
+    {
+        //nothing reads the list, but don't keep neighbors around
+        //that may have been removed from the world since
+        m_neighborhood.clear();
+    }
+}
+
 Vector2 steer::FlockingComponent::calculateWeightedSum()
 {
-    if (on(steer::behaviorType::separation))
+	if (on(steer::behaviorType::separation) && on(steer::behaviorType::alignment) && on(steer::behaviorType::cohesion))
 	{
-		m_steeringForce += Separation< FlockingComponent*, std::vector<FlockingComponent*> >(this, *m_neighbors) * m_weightSeparation;
-	}
+		//all three in one pass over the neighbors
+		FlockingForces flock = flockingForces();
 
-	if (on(steer::behaviorType::alignment))
-	{
-		m_steeringForce += Alignment< FlockingComponent*, std::vector<FlockingComponent*> >(this, *m_neighbors) * m_weightAlignment;
+		m_steeringForce += flock.separation * m_weightSeparation;
+		m_steeringForce += flock.alignment * m_weightAlignment;
+		m_steeringForce += flock.cohesion * m_weightCohesion;
 	}
-
-	if (on(steer::behaviorType::cohesion))
+	else
 	{
-		m_steeringForce += Cohesion< FlockingComponent*, std::vector<FlockingComponent*> >(this, *m_neighbors) * m_weightCohesion;
+		if (on(steer::behaviorType::separation))
+		{
+			m_steeringForce += separationForce() * m_weightSeparation;
+		}
+
+		if (on(steer::behaviorType::alignment))
+		{
+			m_steeringForce += alignmentForce() * m_weightAlignment;
+		}
+
+		if (on(steer::behaviorType::cohesion))
+		{
+			m_steeringForce += cohesionForce() * m_weightCohesion;
+		}
 	}
 
 	if (on(steer::behaviorType::wander))
@@ -80,12 +128,12 @@ Vector2 steer::FlockingComponent::calculateWeightedSum()
 
 	if (on(steer::behaviorType::wallAvoidance))
     {
-        m_steeringForce += WallAvoidance< FlockingComponent* >(this, *m_walls) * m_weightWallAvoidance;
+        m_steeringForce += wallAvoidanceForce() * m_weightWallAvoidance;
     }
 
     if (on(steer::behaviorType::obstacleAvoidance))
     {
-        m_steeringForce += ObstacleAvoidance< FlockingComponent* >(this, *m_obstacles, *m_params) * m_weightObstacleAvoidance;
+        m_steeringForce += obstacleAvoidanceForce() * m_weightObstacleAvoidance;
     }
 
 	m_steeringForce = steer::VectorMath::truncate(m_steeringForce, getMaxForce());
@@ -93,42 +141,180 @@ Vector2 steer::FlockingComponent::calculateWeightedSum()
 	return m_steeringForce;
 }
 
-bool steer::FlockingComponent::targetAcquired()
+Vector2 steer::FlockingComponent::calculatePrioritized()
 {
-	return getPosition() == getTarget();
-}
+    Vector2 force;
 
-void steer::FlockingComponent::Update(float dt)
-{
-    //update the time elapsed
-    m_timeElapsed += dt;
+    if (on(steer::behaviorType::wallAvoidance))
+    {
+        force = wallAvoidanceForce() * m_weightWallAvoidance;
 
-    //keep a record of its old position so we can update its cell later
-    //in this method
-    Vector2 OldPosition = getPosition();
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
+    }
 
-    //calculate the combined force from each steering behavior in the
-    //vehicle's list
-    Vector2 SteeringForce = Calculate();
+    if (on(steer::behaviorType::obstacleAvoidance))
+    {
+        force = obstacleAvoidanceForce() * m_weightObstacleAvoidance;
 
-    //Acceleration = Force/Mass
-    Vector2 acceleration = SteeringForce / getMass();
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
+    }
 
-    //update velocity
-    m_velocity += acceleration * dt;
+    //there is force left for the flocking behaviors, now it
+    //is worth looking for neighbors
+    FlockingForces flock;
 
-    //make sure vehicle does not exceed maximum velocity
-    m_velocity = steer::VectorMath::truncate(m_velocity, getMaxSpeed());
+    if (on(steer::behaviorType::separation) || on(steer::behaviorType::alignment) || on(steer::behaviorType::cohesion))
+    {
+        tagNeighbors();
 
-    //update the position
-    m_agentPosition += m_velocity * dt;
-    m_rotation = steer::VectorMath::findAngle(m_velocity);
+        flock = flockingForces();
+    }
 
-    //update the heading if the vehicle has a non zero velocity
-    if (steer::VectorMath::lengthSquared(m_velocity) > 0.00000001f)
+    if (on(steer::behaviorType::separation))
     {
-        m_heading = steer::VectorMath::normalize(m_velocity);
+        force = flock.separation * m_weightSeparation;
 
-        m_side = steer::VectorMath::perpendicular(m_heading);
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
     }
+
+    if (on(steer::behaviorType::alignment))
+    {
+        force = flock.alignment * m_weightAlignment;
+
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
+    }
+
+    if (on(steer::behaviorType::cohesion))
+    {
+        force = flock.cohesion * m_weightCohesion;
+
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
+    }
+
+    if (on(steer::behaviorType::seek))
+    {
+        force = Seek(this) * m_weightSeek;
+
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
+    }
+
+    if (on(steer::behaviorType::wander))
+    {
+        force = Wander(this) * m_weightWander;
+
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
+    }
+
+    return m_steeringForce;
+}
+
+//---------------------- CalculateDithered -------------------------------
+//
+//  each active behavior is evaluated with the probability set for it in
+//  the parameters, in order of priority. The first behavior to produce a
+//  force wins, scaled up by the inverse of its probability so that on
+//  average it pulls as hard as it would if evaluated every tick.
+//------------------------------------------------------------------------
+Vector2 steer::FlockingComponent::calculateDithered()
+{
+    //neighbors are only gathered once a flocking behavior is picked
+    bool neighborsGathered = false;
+
+    auto gatherNeighbors = [this, &neighborsGathered]()
+    {
+        if (!neighborsGathered)
+        {
+            tagNeighbors();
+            neighborsGathered = true;
+        }
+    };
+
+    if (ditherForce(steer::behaviorType::wallAvoidance, m_params->prWallAvoidance, m_weightWallAvoidance,
+                    [this]() { return wallAvoidanceForce(); }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::obstacleAvoidance, m_params->prObstacleAvoidance, m_weightObstacleAvoidance,
+                    [this]() { return obstacleAvoidanceForce(); }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::separation, m_params->prSeparation, m_weightSeparation,
+                    [this, &gatherNeighbors]() -> Vector2 { gatherNeighbors(); return separationForce(); }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::alignment, m_params->prAlignment, m_weightAlignment,
+                    [this, &gatherNeighbors]() -> Vector2 { gatherNeighbors(); return alignmentForce(); }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::cohesion, m_params->prCohesion, m_weightCohesion,
+                    [this, &gatherNeighbors]() -> Vector2 { gatherNeighbors(); return cohesionForce(); }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::wander, m_params->prWander, m_weightWander,
+                    [this]() { return Wander(this); }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::seek, m_params->prSeek, m_weightSeek,
+                    [this]() { return Seek(this); }))
+        return m_steeringForce;
+
+    return m_steeringForce;
+}
+
+FlockingForces steer::FlockingComponent::flockingForces()
+{
+    //one pack per thread, agents may be updated in parallel
+    static thread_local NeighborPack pack;
+
+    //the neighborhood only holds agents within range
+	return Flocking(this, m_neighborhood, pack, AnyNeighbor());
+}
+
+Vector2 steer::FlockingComponent::separationForce()
+{
+    //the neighborhood only holds agents within range
+	return Separation(this, m_neighborhood, AnyNeighbor());
+}
+
+Vector2 steer::FlockingComponent::alignmentForce()
+{
+	return Alignment(this, m_neighborhood, AnyNeighbor());
+}
+
+Vector2 steer::FlockingComponent::cohesionForce()
+{
+	return Cohesion(this, m_neighborhood, AnyNeighbor());
+}
+
+Vector2 steer::FlockingComponent::wallAvoidanceForce()
+{
+	if (m_wallIndex != nullptr)
+		return WallAvoidance(this, *m_wallIndex);
+
+	return WallAvoidance< FlockingComponent* >(this, *m_walls);
+}
+
+Vector2 steer::FlockingComponent::obstacleAvoidanceForce()
+{
+	if (m_obstacleIndex != nullptr)
+		return ObstacleAvoidance(this, *m_obstacleIndex, *m_params);
+
+	return ObstacleAvoidance< FlockingComponent* >(this, *m_obstacles, *m_params);
+}
+
+bool steer::FlockingComponent::targetAcquired()
+{
+	return getPosition() == getTarget();
+}
+
+void steer::FlockingComponent::Update(float dt)
+{
+    //update the time elapsed
+    m_timeElapsed = dt;
+
+    //calculate the combined force from each steering behavior in the
+    //vehicle's list
+    Calculate();
+
+    //move the agent according to the force
+    integrate(dt);
 }
@@ -7,7 +7,6 @@ steer::PathFollowingComponent::PathFollowingComponent(steer::BehaviorParameters*
 : Agent(params)
 , m_weightPathFollowing(params->FollowPathWeight)
 , m_iFlags()
-, m_rotation(0.f)
 , m_path(nullptr)
 , m_params(params)
 {
@@ -18,7 +17,6 @@ steer::PathFollowingComponent::PathFollowingComponent(steer::Path* p, steer::Beh
 : Agent(params)
 , m_weightPathFollowing(params->FollowPathWeight)
 , m_iFlags()
-, m_rotation(0.f)
 , m_path(p)
 , m_params(params)
 {
@@ -37,7 +35,10 @@ Vector2 steer::PathFollowingComponent::Calculate()
 
     if(isPathFollowingOn())
     {
-        m_steeringForce = PathFollowing(this, m_path, *m_params) * getWeight();
+        if (m_path != nullptr)
+            m_steeringForce = PathFollowing(this, m_path, *m_params) * getWeight();
+        else
+            m_steeringForce = PathFollowing(this, m_pathCursor, *m_params) * getWeight();
     }
 
     return m_steeringForce;
@@ -51,34 +52,12 @@ bool steer::PathFollowingComponent::targetAcquired()
 void steer::PathFollowingComponent::Update(float dt)
 {
     //update the time elapsed
-    m_timeElapsed += dt;
-
-    //keep a record of its old position so we can update its cell later
-    //in this method
-    Vector2 OldPosition = getPosition();
+    m_timeElapsed = dt;
 
     //calculate the combined force from each steering behavior in the
     //vehicle's list
-    Vector2 SteeringForce = Calculate();
-
-    //Acceleration = Force/Mass
-    Vector2 acceleration = SteeringForce / getMass();
-
-    //update velocity
-    m_velocity += acceleration * dt;
-
-    //make sure vehicle does not exceed maximum velocity
-    m_velocity = steer::VectorMath::truncate(m_velocity,getMaxSpeed());
+    Calculate();
 
-    //update the position
-    m_agentPosition += m_velocity * dt;
-	m_rotation = steer::VectorMath::findAngle(m_velocity);
-
-    //update the heading if the vehicle has a non zero velocity
-    if (steer::VectorMath::lengthSquared(m_velocity) > 0.00000001f)
-    {
-        m_heading = steer::VectorMath::normalize(m_velocity);
-
-        m_side = steer::VectorMath::perpendicular(m_heading);
-    }
+    //move the agent according to the force
+    integrate(dt);
 }
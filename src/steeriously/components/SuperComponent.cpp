@@ -20,17 +20,22 @@ steer::SuperComponent::SuperComponent(steer::BehaviorParameters* params)
 	, m_weightCohesion(params->CohesionWeight)
 	, m_weightObstacleAvoidance(params->ObstacleAvoidanceWeight)
 	, m_weightWallAvoidance(params->WallAvoidanceWeight)
+	, m_weightPathFollowing(params->FollowPathWeight)
 	, m_iFlags()
-	, m_rotation(0.f)
-	, m_evadeAgent(nullptr)
-	, m_pursuitAgent(nullptr)
-	, m_leader(nullptr)
-	, m_interposeAgentA(nullptr)
-	, m_interposeAgentB(nullptr)
-	, m_hideAgent(nullptr)
+	, m_archetypeFlag(nullptr)
+	, m_steps()
+	, m_evadeAgent()
+	, m_pursuitAgent()
+	, m_leader()
+	, m_interposeAgentA()
+	, m_interposeAgentB()
+	, m_hideAgent()
 	, m_neighbors(nullptr)
 	, m_obstacles(nullptr)
+	, m_obstacleIndex(nullptr)
 	, m_walls(nullptr)
+	, m_wallIndex(nullptr)
+	, m_path(nullptr)
 	, m_params(params)
 {
     arriveOff();
@@ -45,7 +50,7 @@ steer::SuperComponent::SuperComponent(steer::BehaviorParameters* params)
     flockingOff();
 
     //stuff for the wander behavior
-	float theta = RandFloat() * TwoPi;
+	float theta = m_random.nextFloat() * TwoPi;
 
 	//create a vector to a target position on the wander circle
 	m_wanderTarget = Vector2(m_wanderRadius * cos(theta), m_wanderRadius * sin(theta));
@@ -58,110 +63,380 @@ steer::SuperComponent::~SuperComponent()
 
 Vector2 steer::SuperComponent::Calculate()
 {
-    //reset the steering force
-    m_steeringForce = steer::Vector2(0.0, 0.0);
+    STEERIOUSLY_PROFILE_SCOPE(steer::profile::calculate);
+
+    //the prioritized and dithered sums gather neighbors themselves,
+    //and only once a flocking behavior actually gets evaluated - until
+    //then the list from the last tick must not be read
+    if (m_summingMethod == steer::summingMethod::weightedSum)
+        tagNeighbors();
+    else
+        m_neighborhood.clear();
+
+    return calculateForce();
+}
 
-	if(on(steer::behaviorType::alignment) && on(steer::behaviorType::separation) && on(steer::behaviorType::cohesion))
+void steer::SuperComponent::tagNeighbors()
+{
+	if(on(steer::behaviorType::alignment) || on(steer::behaviorType::separation) || on(steer::behaviorType::cohesion))
+    {
+        //gather the neighbors from the surrounding cells when a cell
+        //space partition is available, otherwise in a scan over every
+        //agent - either way no other agent is written to
+        if (m_cellSpace != nullptr)
+            GatherVehiclesWithinViewRange(this, *m_cellSpace, this->m_viewDistance, m_neighborhood);
+        else
+            GatherVehiclesWithinViewRange(this, *m_neighbors, this->m_viewDistance, m_neighborhood);
+    }
+    else
     {
-        //tag neighbors...
-        TagVehiclesWithinViewRange(this, *m_neighbors, this->m_viewDistance);
+        //nothing reads the list, but don't keep neighbors around
+        //that may have been removed from the world since
+        m_neighborhood.clear();
     }
+}
+
+Vector2 steer::SuperComponent::calculateForce()
+{
+    //reset the steering force
+    m_steeringForce = steer::Vector2(0.0, 0.0);
 
     //calculate the force, Luke ;)
-	m_steeringForce = calculateWeightedSum();
+    switch (m_summingMethod)
+    {
+    case steer::summingMethod::prioritized:
+        m_steeringForce = calculatePrioritized();
+        break;
+
+    case steer::summingMethod::dithered:
+        m_steeringForce = calculateDithered();
+        break;
+
+    default:
+        m_steeringForce = calculateWeightedSum();
+        break;
+    }
 
 	return m_steeringForce;
 }
 
 Vector2 steer::SuperComponent::calculateWeightedSum()
 {
-    if(on(steer::behaviorType::evade))
+	//the flags were decoded into the behaviors to sum when they were
+	//set, each step adds its weighted force to the total
+	for (auto step : m_steps)
+		step(*this, m_steeringForce);
+
+	m_steeringForce = steer::VectorMath::truncate(m_steeringForce, getMaxForce());
+
+	return m_steeringForce;
+}
+
+//---------------------- CalculatePrioritized ----------------------------
+//
+//  this method calls each active steering behavior in order of priority
+//  and acumulates their forces until the max steering force magnitude
+//  is reached, at which time the function returns the steering force
+//  accumulated to that point. Behaviors further down the list are not
+//  evaluated at all.
+//------------------------------------------------------------------------
+Vector2 steer::SuperComponent::calculatePrioritized()
+{
+    Vector2 force;
+
+    if (on(steer::behaviorType::wallAvoidance))
     {
-        m_steeringForce = Evade(this, m_evadeAgent) * m_weightEvade;
+        force = wallAvoidanceForce() * m_weightWallAvoidance;
+
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
     }
 
-    if (on(steer::behaviorType::separation))
-	{
-		m_steeringForce += Separation< SuperComponent*, std::vector<SuperComponent*> >(this, *m_neighbors) * m_weightSeparation;
-	}
+    if (on(steer::behaviorType::obstacleAvoidance))
+    {
+        force = obstacleAvoidanceForce() * m_weightObstacleAvoidance;
 
-	if (on(steer::behaviorType::alignment))
-	{
-		m_steeringForce += Alignment< SuperComponent*, std::vector<SuperComponent*> >(this, *m_neighbors) * m_weightAlignment;
-	}
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
+    }
 
-	if (on(steer::behaviorType::cohesion))
-	{
-		m_steeringForce += Cohesion< SuperComponent*, std::vector<SuperComponent*> >(this, *m_neighbors) * m_weightCohesion;
-	}
+    if (on(steer::behaviorType::evade))
+    {
+        assert(getEvadeAgent() && "evade target not assigned");
 
-	if (on(steer::behaviorType::wander))
-	{
-		m_steeringForce = Wander(this) * m_weightWander;
-	}
+        force = Evade(this, getEvadeAgent()) * m_weightEvade;
 
-	if (on(steer::behaviorType::seek))
-	{
-		m_steeringForce += Seek(this) * m_weightSeek;
-	}
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
+    }
 
     if (on(steer::behaviorType::flee))
     {
-        m_steeringForce += Flee(this) * m_weightFlee;
+        force = Flee(this) * m_weightFlee;
+
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
+    }
+
+    //there is force left for the flocking behaviors, now it
+    //is worth looking for neighbors
+    FlockingForces flock;
+
+    if (on(steer::behaviorType::separation) || on(steer::behaviorType::alignment) || on(steer::behaviorType::cohesion))
+    {
+        tagNeighbors();
+
+        flock = flockingForces();
+    }
+
+    if (on(steer::behaviorType::separation))
+    {
+        force = flock.separation * m_weightSeparation;
+
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
+    }
+
+    if (on(steer::behaviorType::alignment))
+    {
+        force = flock.alignment * m_weightAlignment;
+
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
+    }
+
+    if (on(steer::behaviorType::cohesion))
+    {
+        force = flock.cohesion * m_weightCohesion;
+
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
+    }
+
+    if (on(steer::behaviorType::seek))
+    {
+        force = Seek(this) * m_weightSeek;
+
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
     }
 
     if (on(steer::behaviorType::arrive))
     {
-        m_steeringForce += Arrive(this, this->m_deceleration) * m_weightArrive;
+        force = Arrive(this, this->m_deceleration) * m_weightArrive;
+
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
+    }
+
+    if (on(steer::behaviorType::wander))
+    {
+        force = Wander(this) * m_weightWander;
+
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
     }
 
     if (on(steer::behaviorType::pursuit))
     {
-        assert(m_pursuitAgent && "pursuit target not assigned");
+        assert(getPursuitAgent() && "pursuit target not assigned");
+
+        force = Pursuit(this, getPursuitAgent()) * m_weightPursuit;
 
-        m_steeringForce += Pursuit(this, m_pursuitAgent) * m_weightPursuit;
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
     }
 
     if (on(steer::behaviorType::offsetPursuit))
     {
-        assert (m_leader && "pursuit target not assigned");
-        assert ((!m_offset.x == 0.f && !m_offset.y == 0.f) && "No offset assigned");
+        assert (getLeader() && "pursuit target not assigned");
 
-        m_steeringForce += OffsetPursuit(this, m_leader, *m_params) * m_weightOffsetPursuit;
+        force = OffsetPursuit(this, getLeader(), *m_params) * m_weightOffsetPursuit;
+
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
     }
 
     if (on(steer::behaviorType::interpose))
     {
-        assert (m_interposeAgentA && m_interposeAgentB && "Interpose agents not assigned");
+        assert (getInterposeAgentA() && getInterposeAgentB() && "Interpose agents not assigned");
+
+        force = Interpose(this, getInterposeAgentA(), getInterposeAgentB(), *m_params) * m_weightInterpose;
 
-        m_steeringForce += Interpose(this, m_interposeAgentA, m_interposeAgentB, *m_params) * m_weightInterpose;
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
     }
 
     if (on(steer::behaviorType::hide))
     {
-        assert(m_hideAgent && "Hide target not assigned");
+        assert(getHideAgent() && "Hide target not assigned");
 
-        m_steeringForce += Hide< SuperComponent* >(this, m_hideAgent, *m_obstacles, *m_params) * m_weightHide;
+        force = hideForce() * m_weightHide;
+
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
     }
 
     if (on(steer::behaviorType::followPath))
     {
-        m_steeringForce += PathFollowing(this, m_path, *m_params) * m_weightPathFollowing;
-    }
+        force = pathFollowingForce() * m_weightPathFollowing;
 
-    if (on(steer::behaviorType::wallAvoidance))
-    {
-        m_steeringForce += WallAvoidance< SuperComponent* >(this, *m_walls) * m_weightWallAvoidance;
+        if (!accumulateForce(m_steeringForce, force)) return m_steeringForce;
     }
 
-    if (on(steer::behaviorType::obstacleAvoidance))
+    return m_steeringForce;
+}
+
+//---------------------- CalculateDithered -------------------------------
+//
+//  each active behavior is evaluated with the probability set for it in
+//  the parameters, in order of priority. The first behavior to produce a
+//  force wins, scaled up by the inverse of its probability so that on
+//  average it pulls as hard as it would if evaluated every tick.
+//------------------------------------------------------------------------
+Vector2 steer::SuperComponent::calculateDithered()
+{
+    //neighbors are only gathered once a flocking behavior is picked
+    bool neighborsGathered = false;
+
+    auto gatherNeighbors = [this, &neighborsGathered]()
     {
-        m_steeringForce += ObstacleAvoidance< SuperComponent* >(this, *m_obstacles, *m_params) * m_weightObstacleAvoidance;
-    }
+        if (!neighborsGathered)
+        {
+            tagNeighbors();
+            neighborsGathered = true;
+        }
+    };
+
+    if (ditherForce(steer::behaviorType::wallAvoidance, m_params->prWallAvoidance, m_weightWallAvoidance,
+                    [this]() { return wallAvoidanceForce(); }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::obstacleAvoidance, m_params->prObstacleAvoidance, m_weightObstacleAvoidance,
+                    [this]() { return obstacleAvoidanceForce(); }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::separation, m_params->prSeparation, m_weightSeparation,
+                    [this, &gatherNeighbors]() -> Vector2 { gatherNeighbors(); return separationForce(); }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::flee, m_params->prFlee, m_weightFlee,
+                    [this]() { return Flee(this); }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::evade, m_params->prEvade, m_weightEvade,
+                    [this]() -> Vector2
+                    {
+                        assert(getEvadeAgent() && "evade target not assigned");
+
+                        return Evade(this, getEvadeAgent());
+                    }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::alignment, m_params->prAlignment, m_weightAlignment,
+                    [this, &gatherNeighbors]() -> Vector2 { gatherNeighbors(); return alignmentForce(); }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::cohesion, m_params->prCohesion, m_weightCohesion,
+                    [this, &gatherNeighbors]() -> Vector2 { gatherNeighbors(); return cohesionForce(); }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::wander, m_params->prWander, m_weightWander,
+                    [this]() { return Wander(this); }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::seek, m_params->prSeek, m_weightSeek,
+                    [this]() { return Seek(this); }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::arrive, m_params->prArrive, m_weightArrive,
+                    [this]() { return Arrive(this, this->m_deceleration); }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::pursuit, m_params->prPursuit, m_weightPursuit,
+                    [this]() -> Vector2
+                    {
+                        assert(getPursuitAgent() && "pursuit target not assigned");
+
+                        return Pursuit(this, getPursuitAgent());
+                    }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::offsetPursuit, m_params->prOffsetPursuit, m_weightOffsetPursuit,
+                    [this]() -> Vector2
+                    {
+                        assert (getLeader() && "pursuit target not assigned");
+
+                        return OffsetPursuit(this, getLeader(), *m_params);
+                    }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::interpose, m_params->prInterpose, m_weightInterpose,
+                    [this]() -> Vector2
+                    {
+                        assert (getInterposeAgentA() && getInterposeAgentB() && "Interpose agents not assigned");
+
+                        return Interpose(this, getInterposeAgentA(), getInterposeAgentB(), *m_params);
+                    }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::hide, m_params->prHide, m_weightHide,
+                    [this]() -> Vector2
+                    {
+                        assert(getHideAgent() && "Hide target not assigned");
+
+                        return hideForce();
+                    }))
+        return m_steeringForce;
+
+    if (ditherForce(steer::behaviorType::followPath, m_params->prFollowPath, m_weightPathFollowing,
+                    [this]() { return pathFollowingForce(); }))
+        return m_steeringForce;
+
+    return m_steeringForce;
+}
 
-	m_steeringForce = steer::VectorMath::truncate(m_steeringForce, getMaxForce());
+FlockingForces steer::SuperComponent::flockingForces()
+{
+    //one pack per thread, agents may be updated in parallel
+    static thread_local NeighborPack pack;
 
-	return m_steeringForce;
+    //the neighborhood only holds agents within range
+	return Flocking(this, m_neighborhood, pack, AnyNeighbor());
+}
+
+Vector2 steer::SuperComponent::separationForce()
+{
+    //the neighborhood only holds agents within range
+	return Separation(this, m_neighborhood, AnyNeighbor());
+}
+
+Vector2 steer::SuperComponent::alignmentForce()
+{
+	return Alignment(this, m_neighborhood, AnyNeighbor());
+}
+
+Vector2 steer::SuperComponent::cohesionForce()
+{
+	return Cohesion(this, m_neighborhood, AnyNeighbor());
+}
+
+Vector2 steer::SuperComponent::wallAvoidanceForce()
+{
+	if (m_wallIndex != nullptr)
+		return WallAvoidance(this, *m_wallIndex);
+
+	return WallAvoidance< SuperComponent* >(this, *m_walls);
+}
+
+Vector2 steer::SuperComponent::obstacleAvoidanceForce()
+{
+	if (m_obstacleIndex != nullptr)
+		return ObstacleAvoidance(this, *m_obstacleIndex, *m_params);
+
+	return ObstacleAvoidance< SuperComponent* >(this, *m_obstacles, *m_params);
+}
+
+Vector2 steer::SuperComponent::pathFollowingForce()
+{
+	if (m_path != nullptr)
+		return PathFollowing(this, m_path, *m_params);
+
+	return PathFollowing(this, m_pathCursor, *m_params);
+}
+
+Vector2 steer::SuperComponent::hideForce()
+{
+	if (m_obstacleIndex != nullptr)
+		return Hide(this, getHideAgent(), *m_obstacleIndex, *m_params);
+
+	return Hide< SuperComponent* >(this, getHideAgent(), *m_obstacles, *m_params);
 }
 
 bool steer::SuperComponent::targetAcquired()
@@ -169,37 +444,59 @@ bool steer::SuperComponent::targetAcquired()
 	return getPosition() == getTarget();
 }
 
-void steer::SuperComponent::Update(float dt)
+void steer::SuperComponent::bindTargets()
 {
-    //update the time elapsed
-    m_timeElapsed += dt;
+	AgentRef* targets[] = { &m_evadeAgent, &m_pursuitAgent, &m_leader, &m_interposeAgentA, &m_interposeAgentB, &m_hideAgent };
 
-    //keep a record of its old position so we can update its cell later
-    //in this method
-    Vector2 OldPosition = getPosition();
+	for (auto& target : targets)
+	{
+		//the target may have been registered after it was set
+		if (!target->handle.isValid() && target->agent != nullptr)
+			*target = AgentRef(target->agent);
+	}
+}
 
-    //calculate the combined force from each steering behavior in the
-    //vehicle's list
-    Vector2 SteeringForce = Calculate();
+bool steer::SuperComponent::hasMovingTarget() const
+{
+	struct Target
+	{
+		steer::behaviorType behavior;
+		const AgentRef*     ref;
+	};
 
-    //Acceleration = Force/Mass
-    Vector2 acceleration = SteeringForce / getMass();
+	const Target targets[] =
+	{
+		{ steer::behaviorType::evade, &m_evadeAgent },
+		{ steer::behaviorType::pursuit, &m_pursuitAgent },
+		{ steer::behaviorType::offsetPursuit, &m_leader },
+		{ steer::behaviorType::interpose, &m_interposeAgentA },
+		{ steer::behaviorType::interpose, &m_interposeAgentB },
+		{ steer::behaviorType::hide, &m_hideAgent }
+	};
+
+	for (auto& target : targets)
+	{
+		if ((m_iFlags & target.behavior) != target.behavior)
+			continue;
 
-    //update velocity
-    m_velocity += acceleration * dt;
+		const Agent* agent = resolve(*target.ref);
+
+		if (agent != nullptr && !agent->isAsleep() && VectorMath::lengthSquared(agent->m_velocity) > agent->m_sleepSpeed * agent->m_sleepSpeed)
+			return true;
+	}
 
-    //make sure vehicle does not exceed maximum velocity
-    m_velocity = steer::VectorMath::truncate(m_velocity, getMaxSpeed());
+	return false;
+}
 
-    //update the position
-    m_agentPosition += m_velocity * dt;
-    m_rotation = steer::VectorMath::findAngle(m_velocity);
+void steer::SuperComponent::Update(float dt)
+{
+    //update the time elapsed
+    m_timeElapsed = dt;
 
-    //update the heading if the vehicle has a non zero velocity
-    if (steer::VectorMath::lengthSquared(m_velocity) > 0.00000001f)
-    {
-        m_heading = steer::VectorMath::normalize(m_velocity);
+    //calculate the combined force from each steering behavior in the
+    //vehicle's list
+    Calculate();
 
-        m_side = steer::VectorMath::perpendicular(m_heading);
-    }
+    //move the agent according to the force
+    integrate(dt);
 }